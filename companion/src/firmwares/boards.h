@@ -453,6 +453,15 @@ inline bool IS_STM32(Board::Type board)
   return IS_TARANIS(board) || IS_FAMILY_HORUS_OR_T16(board) || IS_FLYSKY_NV14(board);
 }
 
+inline bool IS_STM32F4(Board::Type board)
+{
+  return IS_FAMILY_HORUS_OR_T16(board) || IS_FLYSKY_EL18(board) || IS_TARANIS_X9E(board) ||
+         board == Board::BOARD_TARANIS_X9DP_2019 || board == Board::BOARD_TARANIS_X7_ACCESS ||
+         board == Board::BOARD_JUMPER_TLITE_F4 || board == Board::BOARD_RADIOMASTER_TX12_MK2 ||
+         board == Board::BOARD_RADIOMASTER_BOXER || board == Board::BOARD_RADIOMASTER_ZORRO ||
+         board == Board::BOARD_IFLIGHT_COMMANDO8;
+}
+
 inline bool IS_ARM(Board::Type board)
 {
   return IS_STM32(board) || IS_SKY9X(board);
@@ -140,7 +140,7 @@ QString CustomFunctionData::paramToString(const ModelData * model) const
     return QString("%1").arg(param);
   }
   else if (func == FuncLogs) {
-    return QString("%1").arg(param / 10.0) + tr("s");
+    return QString("%1").arg(logsPeriodToSeconds(param)) + tr("s");
   }
   else if (func == FuncPlaySound) {
     return playSoundToString(param);
@@ -477,6 +477,28 @@ bool CustomFunctionData::isParamAvailable() const
   return funcList.contains(func) ? false : true;
 }
 
+// Logs period parameter, as on the radio (radio/src/sdcard.h): 1..255 in
+// 0.1s, or 256..264 for the fast periods in 0.01s (0.01s..0.09s). The fast
+// periods are not understood by older firmware and Companion versions
+#define LOGS_PERIOD_FAST_PARAM  255
+#define LOGS_PERIOD_FAST_COUNT  9
+
+//  static
+double CustomFunctionData::logsPeriodToSeconds(const int value)
+{
+  if (value > LOGS_PERIOD_FAST_PARAM)
+    return (value - LOGS_PERIOD_FAST_PARAM) / 100.0;
+  return value / 10.0;
+}
+
+//  static
+int CustomFunctionData::logsPeriodFromSeconds(const double seconds)
+{
+  if (seconds < 0.095)
+    return LOGS_PERIOD_FAST_PARAM + qBound(1, qRound(seconds * 100), LOGS_PERIOD_FAST_COUNT);
+  return qBound(1, qRound(seconds * 10), LOGS_PERIOD_FAST_PARAM);
+}
+
 bool CustomFunctionData::isRepeatParamAvailable() const
 {
   return isRepeatParamAvailable(func);
@@ -133,6 +133,8 @@ class CustomFunctionData {
     static QStringList playSoundStringList();
     static QString playSoundToString(const int value);
     static QString harpicToString(const int value);
+    static double logsPeriodToSeconds(const int value);
+    static int logsPeriodFromSeconds(const double seconds);
     static QStringList gvarAdjustModeStringList();
     static QString gvarAdjustModeToString(const int value);
     static AbstractStaticItemModel * repeatItemModel();
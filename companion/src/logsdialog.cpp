@@ -651,16 +651,189 @@ void LogsDialog::saveSession()
   }
 }
 
+// Binary logs written by the radio, see radio/src/logs_encoder.h
+#define LOGS_BLOCK_SIZE       512
+#define LOGS_MAGIC            "ETXLOG"
+#define LOGS_VERSION          1
+
+#define LOGS_RECORD_HEADER    'H'
+#define LOGS_RECORD_ROW       'R'
+
+enum LogsColumnType {
+  LOGS_COLUMN_VALUE,
+  LOGS_COLUMN_TIME,
+  LOGS_COLUMN_RTC,
+  LOGS_COLUMN_GPS,
+  LOGS_COLUMN_DATETIME,
+  LOGS_COLUMN_TEXT,
+  LOGS_COLUMN_BITS64,
+};
+
+static bool isBinaryLog(QFile & file)
+{
+  return file.peek(1 + strlen(LOGS_MAGIC)) == QByteArray(1, LOGS_RECORD_HEADER) + LOGS_MAGIC;
+}
+
+static bool readVarint(const QByteArray & data, int & pos, quint32 & value)
+{
+  value = 0;
+  for (int shift = 0; shift < 35 && pos < data.size(); shift += 7) {
+    quint8 byte = data.at(pos++);
+    value |= quint32(byte & 0x7F) << shift;
+    if (!(byte & 0x80))
+      return true;
+  }
+  return false;
+}
+
+static QString formatLogPrec(qint32 value, int prec)
+{
+  if (prec == 0)
+    return QString::number(value);
+  qint64 divisor = prec == 1 ? 10 : prec == 2 ? 100 : 1000000;
+  qint64 absValue = qAbs(qint64(value));
+  return QString("%1%2.%3").arg(value < 0 ? "-" : "").arg(absValue / divisor).arg(absValue % divisor, prec, 10, QChar('0'));
+}
+
+static QString formatLogColumn(quint8 type, quint8 prec, const qint32 * values, const QString & text)
+{
+  switch (type) {
+    case LOGS_COLUMN_TIME:
+      return QString::number(values[0]);
+    case LOGS_COLUMN_RTC: {
+      QDateTime time = QDateTime::fromMSecsSinceEpoch(qint64(quint32(values[0])) * 1000, Qt::UTC);
+      return time.toString("yyyy-MM-dd,hh:mm:ss") + QString(".%1").arg(values[1], 2, 10, QChar('0')) + "0";
+    }
+    case LOGS_COLUMN_GPS:
+      if (values[0] && values[1])
+        return formatLogPrec(values[0], 6) + " " + formatLogPrec(values[1], 6);
+      return QString();
+    case LOGS_COLUMN_DATETIME:
+      return QString("%1-%2-%3 %4:%5:%6")
+          .arg(values[0] / 10000, 4, 10, QChar('0')).arg(values[0] / 100 % 100, 2, 10, QChar('0')).arg(values[0] % 100, 2, 10, QChar('0'))
+          .arg(values[1] / 10000, 2, 10, QChar('0')).arg(values[1] / 100 % 100, 2, 10, QChar('0')).arg(values[1] % 100, 2, 10, QChar('0'));
+    case LOGS_COLUMN_TEXT:
+      return QString("\"%1\"").arg(text);
+    case LOGS_COLUMN_BITS64:
+      return "0x" + QString("%1%2").arg(quint32(values[0]), 8, 16, QChar('0')).arg(quint32(values[1]), 8, 16, QChar('0')).toUpper();
+    default:
+      return formatLogPrec(values[0], prec);
+  }
+}
+
+static int logColumnValues(quint8 type)
+{
+  switch (type) {
+    case LOGS_COLUMN_VALUE:
+    case LOGS_COLUMN_TIME:
+      return 1;
+    case LOGS_COLUMN_TEXT:
+      return 0;
+    default:
+      return 2;
+  }
+}
+
+// Decodes a binary log into the CSV rows (the header first), returns the
+// number of rows which could not be used
+static int binaryLogParse(const QByteArray & data, QList<QStringList> & rows)
+{
+  QVector<QPair<quint8, quint8>> columns;
+  QVector<qint32> previous;
+  bool sameColumns = false;
+  int errors = 0;
+  int pos = 0;
+
+  while (pos < data.size()) {
+    char record = data.at(pos);
+    if (record == LOGS_RECORD_HEADER) {
+      pos += 1 + strlen(LOGS_MAGIC);
+      if (data.mid(pos - strlen(LOGS_MAGIC), strlen(LOGS_MAGIC)) != LOGS_MAGIC || pos >= data.size() || data.at(pos) != LOGS_VERSION)
+        return errors + 1;
+      pos++;
+      quint32 count;
+      if (!readVarint(data, pos, count))
+        return errors + 1;
+      columns.clear();
+      QStringList labels;
+      int values = 0;
+      for (quint32 i = 0; i < count; i++) {
+        int end = data.indexOf('\0', pos + 2);
+        if (end < 0)
+          return errors + 1;
+        columns.append(qMakePair(quint8(data.at(pos)), quint8(data.at(pos + 1))));
+        labels.append(QString::fromUtf8(data.mid(pos + 2, end - pos - 2)).split(','));
+        values += logColumnValues(columns.last().first);
+        pos = end + 1;
+      }
+      previous.fill(0, values);
+      // the logs appended to the same file usually share their header
+      if (rows.isEmpty())
+        rows.append(labels);
+      sameColumns = (labels == rows.first());
+    }
+    else if (record == LOGS_RECORD_ROW) {
+      pos++;
+      QStringList fields;
+      int index = 0;
+      for (const auto & column: columns) {
+        QString text;
+        qint32 values[2] = {0, 0};
+        quint32 value;
+        if (column.first == LOGS_COLUMN_TEXT) {
+          if (!readVarint(data, pos, value))
+            return errors + 1;
+          text = QString::fromUtf8(data.mid(pos, value));
+          pos += value;
+        }
+        for (int i = 0; i < logColumnValues(column.first); i++) {
+          if (!readVarint(data, pos, value))
+            return errors + 1;
+          qint32 delta = qint32(value >> 1) ^ -qint32(value & 1);
+          previous[index] = qint32(quint32(previous[index]) + quint32(delta));
+          values[i] = previous[index++];
+        }
+        fields.append(formatLogColumn(column.first, column.second, values, text).split(','));
+      }
+      if (sameColumns)
+        rows.append(fields);
+      else
+        errors++;
+    }
+    else {
+      // end of block
+      pos = (pos / LOGS_BLOCK_SIZE + 1) * LOGS_BLOCK_SIZE;
+      previous.fill(0);
+    }
+  }
+
+  return errors;
+}
+
 bool LogsDialog::cvsFileParse()
 {
   QFile file(ui->FileName_LE->text());
   int errors=0;
   int lines=-1;
 
-  if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) { // reading HEX TEXT file
+  if (!file.open(QIODevice::ReadOnly)) {
     return false;
   }
+  else if (isBinaryLog(file)) {
+    csvlog.clear();
+    errors = binaryLogParse(file.readAll(), csvlog);
+    lines = csvlog.count() - 1 + errors;
+    if (csvlog.isEmpty() || !csvlog.first().join(",").startsWith("Date,Time")) {
+      csvlog.clear();
+      return false;
+    }
+    logFilename = QFileInfo(file.fileName()).baseName();
+  }
   else {
+    file.close();
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) { // reading HEX TEXT file
+      return false;
+    }
     csvlog.clear();
     logFilename.clear();
     QTextStream inputStream(&file);
@@ -383,13 +383,13 @@ void CustomFunctionsPanel::refreshCustomFunction(int i, bool modified)
       }
     }
     else if (func == FuncLogs) {
-      fswtchParam[i]->setDecimals(1);
-      fswtchParam[i]->setMinimum(0);
+      fswtchParam[i]->setDecimals(2);
+      fswtchParam[i]->setMinimum(0.01);
       fswtchParam[i]->setMaximum(25.5);
-      fswtchParam[i]->setSingleStep(0.1);
+      fswtchParam[i]->setSingleStep(fswtchParam[i]->value() < 0.1 ? 0.01 : 0.1);
       if (modified)
-        cfn.param = fswtchParam[i]->value() * 10.0;
-      fswtchParam[i]->setValue(cfn.param / 10.0);
+        cfn.param = CustomFunctionData::logsPeriodFromSeconds(fswtchParam[i]->value());
+      fswtchParam[i]->setValue(CustomFunctionData::logsPeriodToSeconds(cfn.param));
       widgetsMask |= CUSTOM_FUNCTION_NUMERIC_PARAM;
     }
     else if (func >= FuncAdjustGV1 && func <= FuncAdjustGVLast) {
@@ -26,6 +26,7 @@
 #include "appdata.h"
 #include "adjustmentreference.h"
 #include "curveimage.h"
+#include "../../radio/src/mixer_cost.h"
 
 #include <QApplication>
 #include <QPainter>
@@ -890,6 +891,62 @@ QString ModelPrinter::printThrottle()
   return result.join(" ");
 }
 
+static int getCurveCost(const ModelData & model, const CurveReference & curve)
+{
+  if (!curve.value)
+    return 0;
+  if (curve.type != CurveReference::CURVE_REF_CUSTOM)
+    return MIXER_COST_CURVE;
+  int index = abs(curve.value) - 1;
+  if (index >= CPN_MAX_CURVES)
+    return MIXER_COST_CURVE;
+  return MIXER_COST_CUSTOM_CURVE + (model.curves[index].smooth ? MIXER_COST_SMOOTH_CURVE : 0);
+}
+
+// special functions run with their switch set, as on the radio
+static int getFunctionsCost(const CustomFunctionData * functions)
+{
+  int cost = 0;
+  for (int i = 0; i < CPN_MAX_SPECIAL_FUNCTIONS; i++) {
+    if (!functions[i].isEmpty())
+      cost += MIXER_COST_FUNCTION;
+  }
+  return cost;
+}
+
+QString ModelPrinter::printMixerCost()
+{
+  int cost = MIXER_COST_BASE;
+
+  for (int i = 0; i < CPN_MAX_EXPOS; i++) {
+    const ExpoData & ed = model.expoData[i];
+    if (!ed.isEmpty())
+      cost += MIXER_COST_INPUT_LINE + getCurveCost(model, ed.curve);
+  }
+
+  for (int i = 0; i < CPN_MAX_MIXERS; i++) {
+    const MixData & md = model.mixData[i];
+    if (md.isEmpty())
+      continue;
+    cost += MIXER_COST_MIX_LINE + getCurveCost(model, md.curve);
+    if (md.speedUp || md.speedDown || md.delayUp || md.delayDown)
+      cost += MIXER_COST_SLOW_DELAY;
+  }
+
+  for (int i = 0; i < CPN_MAX_LOGICAL_SWITCHES; i++) {
+    if (!model.logicalSw[i].isEmpty())
+      cost += MIXER_COST_LOGICAL_SWITCH;
+  }
+
+  cost += getFunctionsCost(model.customFn);
+  if (model.radioGFDisabled == 2 || (model.radioGFDisabled == 0 && !generalSettings.radioGFDisabled))
+    cost += getFunctionsCost(generalSettings.customFn);
+
+  int cpuPercent = IS_STM32F4(firmware->getBoard()) ? MIXER_COST_CPU_PERCENT_STM32F4 : MIXER_COST_CPU_PERCENT_STM32F2;
+
+  return tr("%1 ms (uncalibrated estimate)").arg(cost * cpuPercent / 1000 / 1000.0, 0, 'f', 2);
+}
+
 QString ModelPrinter::printPPMFrameLength(int ppmFL)
 {
   double result = (((double)ppmFL * 5) + 225) / 10;
@@ -102,6 +102,7 @@ class ModelPrinter: public QObject
     QString printTelemetryScreenType(unsigned int val);
     QString printTelemetryScreen(unsigned int idx, unsigned int line, unsigned int width);
     QString printChecklist();
+    QString printMixerCost();
     const GeneralSettings * gs() { return &generalSettings; }
 
   private:
@@ -326,6 +326,7 @@ QString MultiModelPrinter::printSetup()
     ROWLABELCOMPARECELL(tr("Pot Warnings"), 0, modelPrinter->printPotWarnings(), 0);
   }
   ROWLABELCOMPARECELL(tr("Other"), 0, modelPrinter->printSettingsOther(), 0);
+  ROWLABELCOMPARECELL(tr("Mixer Run"), 0, modelPrinter->printMixerCost(), 0);
   columns.appendTableEnd();
   str.append(columns.print());
   return str;
@@ -38,6 +38,8 @@
 #include "tasks/mixer_task.h"
 
 #include "cli.h"
+#include "input_record.h"
+#include "pulses/rf_latency.h"
 
 #include <ctype.h>
 #include <malloc.h>
@@ -1460,6 +1462,111 @@ int cliShowJitter(const char ** argv)
 }
 #endif
 
+int cliLatency(const char ** argv)
+{
+  if (argv[1] && !strcmp(argv[1], "reset")) {
+    mixerTaskResetLatencies();
+    return 0;
+  }
+
+  for (uint8_t set = 0; set < MIXER_LATENCY_PERIODS; set++) {
+    if (!mixerTaskGetLatencyPeriod(set))
+      continue;
+
+    cliSerialPrint("mixer period %dus%s, durations in us",
+                   mixerTaskGetLatencyPeriod(set), set == 0 ? " (current)" : "");
+    cliSerialPrint("%-10s %8s %6s %6s %6s %6s", "", "count", "p50", "p99", "p999", "max");
+    for (uint8_t i = 0; i < MIXER_LATENCY_COUNT; i++) {
+      const LatencyHistogram & histogram = mixerTaskGetLatency(i, set);
+      cliSerialPrint("%-10s %8u %6u %6u %6u %6u", mixerLatencyNames[i],
+                     (unsigned)histogram.getCount(),
+                     (unsigned)histogram.getPercentile(500) / 2,
+                     (unsigned)histogram.getPercentile(990) / 2,
+                     (unsigned)histogram.getPercentile(999) / 2,
+                     (unsigned)histogram.getMax() / 2);
+    }
+
+    if (argv[1] && !strcmp(argv[1], "buckets")) {
+      for (uint8_t i = 0; i < MIXER_LATENCY_COUNT; i++) {
+        const LatencyHistogram & histogram = mixerTaskGetLatency(i, set);
+        cliSerialPrint("%s:", mixerLatencyNames[i]);
+        for (uint8_t j = 0; j < LATENCY_HISTOGRAM_BUCKETS; j++) {
+          if (histogram.getBucket(j)) {
+            uint16_t bound = LatencyHistogram::bucketMax(j);
+            cliSerialPrint("  <=%5u.%uus %u", bound / 2, (bound & 1) * 5,
+                           (unsigned)histogram.getBucket(j));
+          }
+        }
+      }
+    }
+  }
+
+  return 0;
+}
+
+int cliRfLatency(const char ** argv)
+{
+  if (argv[1] && !strcmp(argv[1], "reset")) {
+    rfLatencyReset();
+    return 0;
+  }
+
+  if (argv[1] && !strcmp(argv[1], "save")) {
+    const char * error = rfLatencySave();
+    if (error) {
+      cliSerialPrint("%s: %s", argv[0], error);
+    }
+    return 0;
+  }
+
+  cliSerialPrint("durations in us");
+  cliSerialPrint("%-9s %-9s %-6s %8s %6s %6s %6s %6s", "module", "protocol",
+                 "", "count", "p50", "p99", "p999", "max");
+  for (uint8_t module = 0; module < MAX_MODULES; module++) {
+    for (uint8_t stage = 0; stage < RF_LATENCY_COUNT; stage++) {
+      const LatencyHistogram & histogram = rfLatencyGet(module, stage);
+      if (!histogram.getCount())
+        continue;
+      cliSerialPrint("%-9s %-9s %-6s %8u %6u %6u %6u %6u",
+                     module == INTERNAL_MODULE ? "internal" : "external",
+                     rfLatencyGetProtocolName(rfLatencyGetProtocol(module)),
+                     rfLatencyStageNames[stage],
+                     (unsigned)histogram.getCount(),
+                     (unsigned)histogram.getPercentile(500) / 2,
+                     (unsigned)histogram.getPercentile(990) / 2,
+                     (unsigned)histogram.getPercentile(999) / 2,
+                     (unsigned)histogram.getMax() / 2);
+    }
+  }
+
+  return 0;
+}
+
+#if defined(INPUT_RECORD)
+int cliRecord(const char ** argv)
+{
+  if (!argv[1]) {
+    if (inputRecordActive())
+      cliSerialPrint("%s: recording to %s", argv[0], inputRecordGetFilename());
+    else if (inputRecordGetError())
+      cliSerialPrint("%s: stopped (%s)", argv[0], inputRecordGetError());
+    else
+      cliSerialPrint("%s: stopped", argv[0]);
+  }
+  else if (!strcmp(argv[1], "start")) {
+    // the main task opens the file
+    inputRecordRequestStart();
+  }
+  else if (!strcmp(argv[1], "stop")) {
+    inputRecordRequestStop();
+  }
+  else {
+    cliSerialPrint("%s: Invalid argument \"%s\"", argv[0], argv[1]);
+  }
+  return 0;
+}
+#endif
+
 #if defined(INTERNAL_GPS)
 int cliGps(const char ** argv)
 {
@@ -1638,6 +1745,11 @@ const CliCommand cliCommands[] = {
   { "help", cliHelp, "[<command>]" },
 #if defined(JITTER_MEASURE)
   { "jitter", cliShowJitter, "" },
+#endif
+  { "latency", cliLatency, "[buckets | reset]" },
+  { "rflatency", cliRfLatency, "[save | reset]" },
+#if defined(INPUT_RECORD)
+  { "record", cliRecord, "[start | stop]" },
 #endif
 #if defined(INTERNAL_GPS)
   { "gps", cliGps, "<baudrate>|$<command>|trace" },
@@ -31,6 +31,27 @@ constexpr int CUSTOM_CURVE_POINTS(int p) { return 2 * p + (2 * DEFAULT_POINTS -
 
 int8_t * curveEnd[MAX_CURVES];
 
+// Per curve data which only depends on the curve points (points abscissa in
+// RESX units, smooth curve tangents). The mixer task builds it after the
+// model was loaded or edited, for the custom and smooth curves used by the
+// inputs, mixes and outputs, in a few slots to keep the RAM use low. The
+// other curves, and the readers racing with a rebuild (the slots are checked
+// through a sequence number, as a seqlock), compute them on the fly.
+#define CURVE_CACHE_SLOTS  8
+
+struct CurveCacheSlot {
+  int16_t x[MAX_POINTS_PER_CURVE];
+  int32_t m[MAX_POINTS_PER_CURVE];        // tangents (smooth curves only)
+};
+
+static struct {
+  volatile uint16_t sequence;             // odd while the mixer task rebuilds it
+  bool valid;
+  uint16_t revision;                      // storageRevision the cache was built from
+  int8_t slots[MAX_CURVES];               // slot of each curve, -1 if not cached
+  CurveCacheSlot data[CURVE_CACHE_SLOTS];
+} curveCache;
+
 uint8_t getCurvePoints(uint8_t index)
 {
   if (index >= MAX_CURVES)
@@ -228,17 +249,109 @@ int32_t compute_tangent(CurveHeader* crv, const int8_t* points, int i)
   return m;
 }
 
+static void getCurveAbscissas(uint8_t idx, int16_t * x)
+{
+  CurveHeader & crv = g_model.curves[idx];
+  int8_t * points = curveAddress(idx);
+  uint8_t count = STD_CURVE_POINTS(crv.points);
+  bool custom = (crv.type == CURVE_TYPE_CUSTOM);
+
+  for (int i = 0; i < count; i++) {
+    if (custom) {
+      x[i] = (i == 0 ? -RESX : (i == count - 1 ? RESX : calc100toRESX(points[count + i - 1])));
+    }
+    else {
+      x[i] = -RESX + (i * 2 * RESX) / (count - 1);
+    }
+  }
+}
+
+static void markCurveUsed(uint32_t & used, int value)
+{
+  if (value < 0)
+    value = -value;
+  if (value > 0 && value <= MAX_CURVES)
+    used |= (uint32_t)1 << (value - 1);
+}
+
+static_assert(MAX_CURVES <= 32, "curvesCacheUpdate() needs a wider mask");
+
+void curvesCacheUpdate()
+{
+  uint16_t revision = storageRevision;
+  if (curveCache.valid && curveCache.revision == revision)
+    return;
+
+  uint32_t used = 0;
+  for (uint8_t i = 0; i < MAX_EXPOS; i++) {
+    const ExpoData * ed = expoAddress(i);
+    if (ed->curve.type == CURVE_REF_CUSTOM)
+      markCurveUsed(used, ed->curve.value);
+  }
+  for (uint8_t i = 0; i < MAX_MIXERS; i++) {
+    const MixData * md = mixAddress(i);
+    if (md->curve.type == CURVE_REF_CUSTOM)
+      markCurveUsed(used, md->curve.value);
+  }
+  for (uint8_t i = 0; i < MAX_OUTPUT_CHANNELS; i++) {
+    markCurveUsed(used, limitAddress(i)->curve);
+  }
+
+  curveCache.sequence++;
+  __sync_synchronize();
+
+  uint8_t slot = 0;
+  for (uint8_t idx = 0; idx < MAX_CURVES; idx++) {
+    CurveHeader & crv = g_model.curves[idx];
+    curveCache.slots[idx] = -1;
+    if (!(used & ((uint32_t)1 << idx)) || slot >= CURVE_CACHE_SLOTS ||
+        (!crv.smooth && crv.type != CURVE_TYPE_CUSTOM))
+      continue;
+    CurveCacheSlot & data = curveCache.data[slot];
+    getCurveAbscissas(idx, data.x);
+    if (crv.smooth) {
+      int8_t * points = curveAddress(idx);
+      for (int i = 0; i < STD_CURVE_POINTS(crv.points); i++) {
+        data.m[i] = compute_tangent(&crv, points, i);
+      }
+    }
+    curveCache.slots[idx] = slot++;
+  }
+  curveCache.revision = revision;
+  curveCache.valid = true;
+
+  __sync_synchronize();
+  curveCache.sequence++;
+}
+
+// cached data of the curve, nullptr if it is not cached or being rebuilt
+static const CurveCacheSlot * getCurveCache(uint8_t idx, uint16_t & sequence)
+{
+  sequence = curveCache.sequence;
+  __sync_synchronize();
+  if ((sequence & 1) || !curveCache.valid || curveCache.revision != storageRevision)
+    return nullptr;
+  int8_t slot = curveCache.slots[idx];
+  return slot >= 0 ? &curveCache.data[slot] : nullptr;
+}
+
+// the cached data read since getCurveCache() was not rebuilt meanwhile
+static bool isCurveCacheUnchanged(uint16_t sequence)
+{
+  __sync_synchronize();
+  return curveCache.sequence == sequence;
+}
+
 /* The following is a hermite cubic spline.
    The basis functions can be found here:
    http://en.wikipedia.org/wiki/Cubic_Hermite_spline
    The tangents are computed via the 'cubic monotone' rules (allowing for local-maxima)
 */
-int16_t hermite_spline(int16_t x, uint8_t idx)
+static int16_t hermite_spline(int16_t x, uint8_t idx, const int16_t * xs, const int32_t * ms)
 {
   CurveHeader &crv = g_model.curves[idx];
   int8_t *points = curveAddress(idx);
   uint8_t count = STD_CURVE_POINTS(crv.points);
-  bool custom = (crv.type == CURVE_TYPE_CUSTOM);
 
   if (x < -RESX)
     x = -RESX;
@@ -246,21 +359,14 @@ int16_t hermite_spline(int16_t x, uint8_t idx)
     x = RESX;
 
   for (int i=0; i<count-1; i++) {
-    int32_t p0x, p3x;
-    if (custom) {
-      p0x = (i>0 ? calc100toRESX(points[count+i-1]) : -RESX);
-      p3x = (i<count-2 ? calc100toRESX(points[count+i]) : RESX);
-    }
-    else {
-      p0x = -RESX + (i*2*RESX)/(count-1);
-      p3x = -RESX + ((i+1)*2*RESX)/(count-1);
-    }
+    int32_t p0x = xs[i];
+    int32_t p3x = xs[i+1];
 
     if (x >= p0x && x <= p3x) {
       int32_t p0y = calc100toRESX(points[i]);
       int32_t p3y = calc100toRESX(points[i+1]);
-      int32_t m0 = compute_tangent(&crv, points, i);
-      int32_t m3 = compute_tangent(&crv, points, i+1);
+      int32_t m0 = (ms ? ms[i] : compute_tangent(&crv, points, i));
+      int32_t m3 = (ms ? ms[i+1] : compute_tangent(&crv, points, i+1));
       int32_t y;
       int32_t h = p3x - p0x;
       int32_t t = (h > 0 ? (MMULT * (x - p0x)) / h : 0);
@@ -278,7 +384,22 @@ int16_t hermite_spline(int16_t x, uint8_t idx)
   return 0;
 }
 
-int intpol(int x, uint8_t idx) // -100, -75, -50, -25, 0 ,25 ,50, 75, 100
+int16_t hermite_spline(int16_t x, uint8_t idx)
+{
+  uint16_t sequence;
+  const CurveCacheSlot * cache = getCurveCache(idx, sequence);
+  if (cache) {
+    int16_t y = hermite_spline(x, idx, cache->x, cache->m);
+    if (isCurveCacheUnchanged(sequence))
+      return y;
+  }
+
+  int16_t xs[MAX_POINTS_PER_CURVE];
+  getCurveAbscissas(idx, xs);
+  return hermite_spline(x, idx, xs, nullptr);
+}
+
+static int intpol(int x, uint8_t idx, const int16_t * xs) // -100, -75, -50, -25, 0 ,25 ,50, 75, 100
 {
   CurveHeader& crv = g_model.curves[idx];
   int8_t* points = curveAddress(idx);
@@ -298,8 +419,7 @@ int intpol(int x, uint8_t idx) // -100, -75, -50, -25, 0 ,25 ,50, 75, 100
     if (custom) {
       for (i = 0; i < count - 1; i++) {
         a = b;
-        b = (i == count - 2 ? 2 * RESX
-                            : RESX + calc100toRESX(points[count + i]));
+        b = RESX + xs[i + 1];
         if ((uint16_t)x <= b) break;
       }
     } else {
@@ -316,6 +436,24 @@ int intpol(int x, uint8_t idx) // -100, -75, -50, -25, 0 ,25 ,50, 75, 100
   return erg / 25; // 100*D5/RESX;
 }
 
+int intpol(int x, uint8_t idx)
+{
+  if (g_model.curves[idx].type != CURVE_TYPE_CUSTOM)
+    return intpol(x, idx, nullptr);
+
+  uint16_t sequence;
+  const CurveCacheSlot * cache = getCurveCache(idx, sequence);
+  if (cache) {
+    int y = intpol(x, idx, cache->x);
+    if (isCurveCacheUnchanged(sequence))
+      return y;
+  }
+
+  int16_t xs[MAX_POINTS_PER_CURVE];
+  getCurveAbscissas(idx, xs);
+  return intpol(x, idx, xs);
+}
+
 int applyCurve(int x, CurveRef & curve)
 {
   switch (curve.type) {
@@ -37,6 +37,8 @@ void curveClear(uint8_t index);
 void curveMirror(uint8_t index);
 bool isCurveUsed(uint8_t index);
 void loadCurves();
+// rebuilds the curves data cache after a model change (mixer task only)
+void curvesCacheUpdate();
 int8_t * curveAddress(uint8_t idx);
 bool moveCurve(uint8_t index, int8_t shift);
 int8_t getCurveX(int noPoints, int point);
@@ -126,6 +126,60 @@ bool isRepeatDelayElapsed(const CustomFunctionData * functions, CustomFunctionsC
   }
 }
 
+// functions which only act when their switch becomes active
+static bool isEdgeTriggeredFunction(const CustomFunctionData * cfn)
+{
+  switch (CFN_FUNC(cfn)) {
+    case FUNC_RESET:
+      return CFN_PARAM(cfn) == FUNC_RESET_FLIGHT;
+#if defined(GVARS)
+    case FUNC_ADJUST_GVAR:
+      return CFN_GVAR_MODE(cfn) == FUNC_ADJUST_GVAR_INCDEC;
+#endif
+    case FUNC_SCREENSHOT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+static void customFunctionsIndexCompile(const CustomFunctionData * functions, CustomFunctionsIndex & index)
+{
+  index.count = 0;
+  index.switchesCount = 0;
+
+  for (uint8_t i = 0; i < MAX_SPECIAL_FUNCTIONS; i++) {
+    const CustomFunctionData * cfn = &functions[i];
+    swsrc_t swtch = CFN_SWITCH(cfn);
+    if (!swtch)
+      continue;
+
+    uint8_t flags = IS_PLAY_FUNC(CFN_FUNC(cfn)) ? GETSWITCH_MIDPOS_DELAY : 0;
+    uint8_t s = 0;
+    while (s < index.switchesCount && (index.switches[s] != swtch || index.switchesFlags[s] != flags)) {
+      s++;
+    }
+    if (s == index.switchesCount) {
+      index.switches[s] = swtch;
+      index.switchesFlags[s] = flags;
+      index.switchesCount++;
+    }
+
+    index.functions[index.count] = i;
+    index.functionsSwitch[index.count] = s | (isEdgeTriggeredFunction(cfn) ? CFN_INDEX_EDGE : 0);
+    index.count++;
+  }
+
+  index.revision = storageRevision;
+}
+
+static inline void customFunctionsIndexUpdate(const CustomFunctionData * functions, CustomFunctionsIndex & index)
+{
+  if (index.revision != storageRevision) {
+    customFunctionsIndexCompile(functions, index);
+  }
+}
+
 #define VOLUME_HYSTERESIS 10            // how much must a input value change to actually be considered for new volume setting
 getvalue_t requiredSpeakerVolumeRawLast = 1024 + 1; //initial value must be outside normal range
 
@@ -149,20 +203,34 @@ void evalFunctions(const CustomFunctionData * functions, CustomFunctionsContext
   }
 #endif
 
-  for (uint8_t i=0; i<MAX_SPECIAL_FUNCTIONS; i++) {
+  customFunctionsIndexUpdate(functions, functionsContext.index);
+  const CustomFunctionsIndex & index = functionsContext.index;
+
+  MASK_CFN_TYPE switchesState = 0;
+  for (uint8_t s = 0; s < index.switchesCount; s++) {
+    if (getSwitch(index.switches[s], index.switchesFlags[s]))
+      switchesState |= ((MASK_CFN_TYPE)1 << s);
+  }
+
+  for (uint8_t p = 0; p < index.count; p++) {
+    uint8_t i = index.functions[p];
     const CustomFunctionData * cfn = &functions[i];
     swsrc_t swtch = CFN_SWITCH(cfn);
     if (swtch) {
       MASK_CFN_TYPE switch_mask = ((MASK_CFN_TYPE)1 << i);
 
-      bool active = getSwitch(
-          swtch, IS_PLAY_FUNC(CFN_FUNC(cfn)) ? GETSWITCH_MIDPOS_DELAY : 0);
+      uint8_t functionSwitch = index.functionsSwitch[p];
+      bool active = switchesState & ((MASK_CFN_TYPE)1 << (functionSwitch & ~CFN_INDEX_EDGE));
 
       if (HAS_ENABLE_PARAM(CFN_FUNC(cfn))) {
         active &= (bool)CFN_ACTIVE(cfn);
       }
 
-      if (active) {
+      if (active && (functionSwitch & CFN_INDEX_EDGE) && (functionsContext.activeSwitches & switch_mask)) {
+        // already done when the switch became active
+        newActiveSwitches |= switch_mask;
+      }
+      else if (active) {
         switch (CFN_FUNC(cfn)) {
 #if defined(OVERRIDE_CHANNEL_FUNCTION)
           case FUNC_OVERRIDE_CHANNEL:
@@ -376,8 +444,7 @@ void evalFunctions(const CustomFunctionData * functions, CustomFunctionsContext
           case FUNC_LOGS:
             if (CFN_PARAM(cfn)) {
               newActiveFunctions |= (1u << FUNCTION_LOGS);
-              logDelay100ms = CFN_PARAM(
-                  cfn);  // logging period is 0..25.5s in 100ms increments
+              logDelay10ms = logsPeriod10ms(CFN_PARAM(cfn));
             }
             break;
 #endif
@@ -64,16 +64,13 @@ extern uint8_t mainRequestFlags;
 
 #define DELAY_POS_MARGIN   3
 
+// delays and slows state is in mixRuntime (mixer_plan.h)
 PACK(struct SwOn {
-  uint16_t delay:14; // max = 2550
   uint8_t  activeMix:1;
   uint8_t  activeExpo:1;
-  int16_t  now;  // timer trigger source -> off, abs, stk, stk%, sw/!sw, !m_sw/!m_sw
-  int16_t  prev;
 });
 
 extern SwOn   swOn[MAX_MIXERS];
-extern int32_t act[MAX_MIXERS];
 
 // static variables used in evalFlightModeMixes - moved here so they don't interfere with the stack
 // It's also easier to initialize them here.
@@ -84,6 +81,8 @@ extern int16_t trims[MAX_TRIMS];
 extern int32_t chans[MAX_OUTPUT_CHANNELS];
 extern int16_t ex_chans[MAX_OUTPUT_CHANNELS]; // Outputs (before LIMITS) of the last perMain
 extern int16_t channelOutputs[MAX_OUTPUT_CHANNELS];
+extern uint16_t channelOutputsSampleTime; // getTmr2MHz() of the ADC sample the outputs come from
+extern uint16_t channelOutputsTime;       // getTmr2MHz() when the outputs were computed
 
 typedef uint16_t BeepANACenter;
 extern BeepANACenter bpanaCenter;
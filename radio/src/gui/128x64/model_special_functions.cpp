@@ -32,7 +32,7 @@
 #endif
 
 #if defined(SDCARD)
-#define SD_LOGS_PERIOD_MIN      1     // 0.1s  fastest period 
+#define SD_LOGS_PERIOD_MIN      (1 - LOGS_PERIOD_FAST_COUNT)  // 0.01s fastest period
 #define SD_LOGS_PERIOD_MAX      255   // 25.5s slowest period 
 #define SD_LOGS_PERIOD_DEFAULT  10    // 1s    default period for newly created SF 
 
@@ -359,11 +359,16 @@ void menuSpecialFunctions(event_t event, CustomFunctionData * functions, CustomF
             val_min = SD_LOGS_PERIOD_MIN; 
             val_max = SD_LOGS_PERIOD_MAX;
 
-            if (!val_displayed) {
-              val_displayed = CFN_PARAM(cfn) = SD_LOGS_PERIOD_DEFAULT;
+            if (!CFN_PARAM(cfn)) {
+              CFN_PARAM(cfn) = SD_LOGS_PERIOD_DEFAULT;
             }
+            val_displayed = logsPeriodIndex(CFN_PARAM(cfn));
 
-            lcdDrawNumber(MODEL_SPECIAL_FUNC_3RD_COLUMN, y, val_displayed, attr|PREC1|LEFT);
+            uint16_t period = logsPeriod10ms(CFN_PARAM(cfn));
+            if (period < 10)
+              lcdDrawNumber(MODEL_SPECIAL_FUNC_3RD_COLUMN, y, period, attr|PREC2|LEFT);
+            else
+              lcdDrawNumber(MODEL_SPECIAL_FUNC_3RD_COLUMN, y, period / 10, attr|PREC1|LEFT);
             lcdDrawChar(lcdLastRightPos, y, 's');
           }
 #endif
@@ -411,6 +416,8 @@ void menuSpecialFunctions(event_t event, CustomFunctionData * functions, CustomF
 #if defined(NAVIGATION_X7)
           if (active || event==EVT_KEY_LONG(KEY_ENTER)) {
             CFN_PARAM(cfn) = CHECK_INCDEC_PARAM(event, val_displayed, val_min, val_max);
+            if (func == FUNC_LOGS)
+              CFN_PARAM(cfn) = logsPeriodParam(CFN_PARAM(cfn));
             if (func == FUNC_ADJUST_GVAR && attr && event==EVT_KEY_LONG(KEY_ENTER)) {
               killEvents(event);
               if (CFN_GVAR_MODE(cfn) != FUNC_ADJUST_GVAR_CONSTANT)
@@ -427,6 +434,8 @@ void menuSpecialFunctions(event_t event, CustomFunctionData * functions, CustomF
 #else
           if (active) {
             CFN_PARAM(cfn) = CHECK_INCDEC_PARAM(event, val_displayed, val_min, val_max);
+            if (func == FUNC_LOGS)
+              CFN_PARAM(cfn) = logsPeriodParam(CFN_PARAM(cfn));
 #endif
           }
           break;
@@ -20,6 +20,7 @@
  */
 
 #include "opentx.h"
+#include "mixer_outputs.h"
 
 constexpr coord_t CHANNEL_NAME_OFFSET = 1;
 constexpr coord_t CHANNEL_VALUE_OFFSET = CHANNEL_NAME_OFFSET + 42;
@@ -82,7 +83,7 @@ void menuChannelsViewCommon(event_t event)
   for (uint8_t line = 0; line < 8; line++) {
     LimitData * ld = limitAddress(ch);
     const uint8_t y = 9 + line * 7;
-    const int32_t val = reusableBuffer.viewChannels.mixersView ? ex_chans[ch] : channelOutputs[ch];
+    const int32_t val = reusableBuffer.viewChannels.mixersView ? mixerOutputs().mixes[ch] : mixerOutputs().channels[ch];
     const uint8_t lenLabel = ZLEN(g_model.limitData[ch].name);
 
     // Channel name if present, number if not
@@ -21,7 +21,9 @@
 
 #include "opentx.h"
 #include "tasks.h"
+#include "tasks/mixer_task.h"
 #include "mixer_scheduler.h"
+#include "mixer_cost.h"
 
 #include "hal/adc_driver.h"
 
@@ -137,6 +139,7 @@ void menuStatisticsDebug(event_t event)
       maxLuaDuration = 0;
 #endif
       maxMixerDuration  = 0;
+      mixerTaskResetLatencies();
       break;
 
     case EVT_KEY_FIRST(KEY_UP):
@@ -210,6 +213,21 @@ void menuStatisticsDebug(event_t event)
   lcdDrawText(lcdLastRightPos, y, "ms)");
   y += FH;
 
+#if !defined(TX_CAPACITY_MEASUREMENT)
+  const LatencyHistogram & cycle = mixerTaskGetLatency(MIXER_LATENCY_CYCLE);
+  lcdDrawTextAlignedLeft(y, STR_TMIXP99);
+  lcdDrawNumber(MENU_DEBUG_COL1_OFS, y, DURATION_MS_PREC2(cycle.getPercentile(990)), PREC2|LEFT);
+  lcdDrawText(lcdLastRightPos, y, "/");
+  lcdDrawNumber(lcdLastRightPos, y, DURATION_MS_PREC2(cycle.getPercentile(999)), PREC2|LEFT);
+  lcdDrawText(lcdLastRightPos, y, STR_MS);
+  y += FH;
+
+  lcdDrawTextAlignedLeft(y, STR_TMIXEST);
+  lcdDrawNumber(MENU_DEBUG_COL1_OFS, y, mixerCostEstimate() / 10, PREC2|LEFT|(isMixerCostHigh() ? BLINK|INVERS : 0));
+  lcdDrawText(lcdLastRightPos, y, STR_MS);
+  y += FH;
+#endif
+
   lcdDrawTextAlignedLeft(y, STR_FREE_STACK);
   lcdDrawNumber(MENU_DEBUG_COL1_OFS, y, menusStack.available(), LEFT);
   lcdDrawText(lcdLastRightPos, y, "/");
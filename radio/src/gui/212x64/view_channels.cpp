@@ -20,6 +20,7 @@
  */
 
 #include "opentx.h"
+#include "mixer_outputs.h"
 
 void menuChannelsView(event_t event)
 {
@@ -73,7 +74,7 @@ void menuChannelsView(event_t event)
     // Channels
     for (uint8_t line=0; line < 8; line++) {
       const uint8_t y = 9 + line * 7;
-      const int32_t val = reusableBuffer.viewChannels.mixersView ? ex_chans[ch] : channelOutputs[ch];
+      const int32_t val = reusableBuffer.viewChannels.mixersView ? mixerOutputs().mixes[ch] : mixerOutputs().channels[ch];
       const uint8_t lenLabel = ZLEN(g_model.limitData[ch].name);
 
       // Channel name if present, number if not
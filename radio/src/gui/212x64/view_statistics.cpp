@@ -22,6 +22,8 @@
 #include "hal/adc_driver.h"
 #include "opentx.h"
 #include "tasks.h"
+#include "tasks/mixer_task.h"
+#include "mixer_cost.h"
 
 #define STATS_1ST_COLUMN               FW/2
 #define STATS_2ND_COLUMN               12*FW+FW/2
@@ -132,6 +134,7 @@ void menuStatisticsDebug(event_t event)
       maxLuaDuration = 0;
 #endif
       maxMixerDuration  = 0;
+      mixerTaskResetLatencies();
       break;
 
     case EVT_KEY_FIRST(KEY_PLUS):
@@ -186,6 +189,19 @@ void menuStatisticsDebug(event_t event)
   lcdDrawText(lcdLastRightPos, y, STR_MS);
   y += FH;
 
+  const LatencyHistogram & cycle = mixerTaskGetLatency(MIXER_LATENCY_CYCLE);
+  lcdDrawTextAlignedLeft(y, STR_TMIXP99);
+  lcdDrawNumber(MENU_DEBUG_COL1_OFS, y, DURATION_MS_PREC2(cycle.getPercentile(990)), PREC2|LEFT);
+  lcdDrawText(lcdLastRightPos, y, "/");
+  lcdDrawNumber(lcdLastRightPos, y, DURATION_MS_PREC2(cycle.getPercentile(999)), PREC2|LEFT);
+  lcdDrawText(lcdLastRightPos, y, STR_MS);
+  y += FH;
+
+  lcdDrawTextAlignedLeft(y, STR_TMIXEST);
+  lcdDrawNumber(MENU_DEBUG_COL1_OFS, y, mixerCostEstimate() / 10, PREC2|LEFT|(isMixerCostHigh() ? BLINK|INVERS : 0));
+  lcdDrawText(lcdLastRightPos, y, STR_MS);
+  y += FH;
+
   lcdDrawTextAlignedLeft(y, STR_FREE_STACK);
   lcdDrawText(MENU_DEBUG_COL1_OFS, y+1, "[M]", SMLSIZE);
   lcdDrawNumber(lcdLastRightPos, y, menusStack.available(), LEFT);
@@ -34,7 +34,7 @@ ChannelBar::ChannelBar(Window* parent, const rect_t& rect, uint8_t channel) :
 
 void MixerChannelBar::paint(BitmapBuffer * dc)
 {
-  int chanVal = calcRESXto100(ex_chans[channel]);
+  int chanVal = calcRESXto100(mixerOutputs().mixes[channel]);
   const int displayVal = chanVal;
 
   // this could be handled nicer, but slower, by checking actual range for this
@@ -73,7 +73,7 @@ void MixerChannelBar::paint(BitmapBuffer * dc)
 void MixerChannelBar::checkEvents()
 {
   Window::checkEvents();
-  int newValue = ex_chans[channel];
+  int newValue = mixerOutputs().mixes[channel];
   if (value != newValue) {
     value = newValue;
     invalidate();
@@ -101,7 +101,7 @@ static void drawOutputBarLimits(BitmapBuffer* dc, coord_t left, coord_t right,
 
 void OutputChannelBar::paint(BitmapBuffer* dc)
 {
-  int chanVal = calcRESXto100(channelOutputs[channel]);
+  int chanVal = calcRESXto100(mixerOutputs().channels[channel]);
   int displayVal = chanVal;
 
   chanVal =
@@ -166,7 +166,7 @@ void OutputChannelBar::paint(BitmapBuffer* dc)
 void OutputChannelBar::checkEvents()
 {
   Window::checkEvents();
-  int newValue = channelOutputs[channel];
+  int newValue = mixerOutputs().channels[channel];
   if (value != newValue) {
     value = newValue;
     invalidate();
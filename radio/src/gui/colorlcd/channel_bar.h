@@ -24,6 +24,7 @@
 #include "opentx.h"
 #include "libopenui.h"
 #include "static.h"
+#include "mixer_outputs.h"
 
 constexpr coord_t ROW_HEIGHT = 42;
 constexpr coord_t BAR_HEIGHT = 13;
@@ -117,7 +118,7 @@ class ComboChannelBar : public Window
     void paint(BitmapBuffer * dc) override
     {
       char chanString[] = TR_CH"32 ";
-      int usValue = PPM_CH_CENTER(channel) + channelOutputs[channel] / 2;
+      int usValue = PPM_CH_CENTER(channel) + mixerOutputs().channels[channel] / 2;
 
       // Channel number
       strAppendSigned(&chanString[2], channel + 1, 2);
@@ -145,7 +146,7 @@ class ComboChannelBar : public Window
     void checkEvents() override
     {
       Window::checkEvents();
-      int newValue = channelOutputs[channel];
+      int newValue = mixerOutputs().channels[channel];
       if (value != newValue) {
         value = newValue;
         invalidate();
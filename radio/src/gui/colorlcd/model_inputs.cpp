@@ -64,8 +64,8 @@ void copyExpo(uint8_t source, uint8_t dest, uint8_t input)
   memmove(expo + 1, expo, trailingExpos * sizeof(ExpoData));
   memcpy(expo, &sourceExpo, sizeof(ExpoData));
   expo->chn = input;
-  mixerTaskStart();
   storageDirty(EE_MODEL);
+  mixerTaskStart();
 }
 
 void deleteExpo(uint8_t idx)
@@ -78,8 +78,8 @@ void deleteExpo(uint8_t idx)
   if (!isInputAvailable(input)) {
     memclear(&g_model.inputNames[input], LEN_INPUT_NAME);
   }
-  mixerTaskStart();
   storageDirty(EE_MODEL);
+  mixerTaskStart();
 }
 
 // TODO port: avoid global s_currCh on ARM boards (as done here)...
@@ -102,8 +102,8 @@ void insertExpo(uint8_t idx, uint8_t input)
   expo->mode = 3; // pos+neg
   expo->chn = input;
   expo->weight = 100;
-  mixerTaskStart();
   storageDirty(EE_MODEL);
+  mixerTaskStart();
 }
 
 class InputLineButton : public InputMixButton
@@ -31,6 +31,9 @@
 #include "input_mix_button.h"
 #include "mixer_edit.h"
 #include "input_mapping.h"
+#include "mixer_plan.h"
+#include "mixer_cost.h"
+#include "mixer_scheduler.h"
 
 #include "tasks/mixer_task.h"
 #include "hal/adc_driver.h"
@@ -87,8 +90,8 @@ void insertMix(uint8_t idx, uint8_t channel)
     }
   }
   mix->weight = 100;
-  mixerTaskStart();
   storageDirty(EE_MODEL);
+  mixerTaskStart();
 }
 
 void deleteMix(uint8_t idx)
@@ -97,8 +100,8 @@ void deleteMix(uint8_t idx)
   MixData * mix = mixAddress(idx);
   memmove(mix, mix + 1, (MAX_MIXERS - (idx + 1)) * sizeof(MixData));
   memclear(&g_model.mixData[MAX_MIXERS - 1], sizeof(MixData));
-  mixerTaskStart();
   storageDirty(EE_MODEL);
+  mixerTaskStart();
 }
 
 #if defined(LUA)
@@ -121,8 +124,8 @@ void copyMix(uint8_t source, uint8_t dest, int8_t ch)
   memmove(mix + 1, mix, trailingMixes * sizeof(MixData));
   memcpy(mix, &sourceMix, sizeof(MixData));
   mix->destCh = ch;
-  mixerTaskStart();
   storageDirty(EE_MODEL);
+  mixerTaskStart();
 }
 
 bool swapMixes(uint8_t &idx, uint8_t up)
@@ -162,6 +165,7 @@ bool swapMixes(uint8_t &idx, uint8_t up)
 
   mixerTaskStop();
   memswap(x, y, sizeof(MixData));
+  storageDirty(EE_MODEL);
   mixerTaskStart();
 
   idx = tgt_idx;
@@ -263,6 +267,11 @@ void MixLineButton::refresh()
   char *s = tmp_str;
   *s = '\0';
 
+  if (isMixInChannelLoop(index)) {
+    int cnt = lv_snprintf(s, maxlen, "%s ", STR_MIX_LOOP);
+    maxlen -= cnt; s += cnt;
+  }
+
   if (line.name[0]) {
     int cnt = lv_snprintf(s, maxlen, "%.*s ", (int)sizeof(line.name), line.name);
     if ((size_t)cnt >= maxlen) maxlen = 0;
@@ -536,6 +545,21 @@ void ModelMixesPage::build(FormWindow * window)
       box, rect_t{}, [=]() { return showMonitors; },
       [=](uint8_t val) { enableMonitors(val); });
 
+  // estimated mixer duration, compared to the mixer period
+  new DynamicText(
+      box, rect_t{},
+      [] {
+        char s[32];
+        uint16_t cost = mixerCostEstimate();
+        snprintf(s, sizeof(s), "%s %d.%02d/%d.%02d%s%s", STR_TMIXEST,
+                 cost / 1000, (cost % 1000) / 10,
+                 getMixerSchedulerPeriod() / 1000,
+                 (getMixerSchedulerPeriod() % 1000) / 10, STR_MS,
+                 isMixerCostHigh() ? " !" : "");
+        return std::string(s);
+      },
+      COLOR_THEME_PRIMARY1);
+
   auto btn = new TextButton(window, rect_t{}, LV_SYMBOL_PLUS, [=]() {
     newMix();
     return 0;
@@ -34,6 +34,14 @@ static const lv_coord_t col_dsc[] = {LV_GRID_FR(2), LV_GRID_FR(3),
 static const lv_coord_t row_dsc[] = {LV_GRID_CONTENT,
                                      LV_GRID_TEMPLATE_LAST};
 
+static std::string getLogsPeriodString(int16_t param)
+{
+  uint16_t period = logsPeriod10ms(param);
+  if (period < 10)
+    return formatNumberAsString(period, PREC2, 0, nullptr, "s");
+  return formatNumberAsString(period / 10, PREC1, 0, nullptr, "s");
+}
+
 class SpecialFunctionEditPage : public Page
 {
  public:
@@ -237,11 +245,18 @@ class SpecialFunctionEditPage : public Page
         if(CFN_PARAM(cfn) == 0)                           // use stored value if SF exists
           CFN_PARAM(cfn) = SD_LOGS_PERIOD_DEFAULT;        // otherwise initialize with default value
 
-        auto edit = addNumberEdit(line, STR_INTERVAL, cfn, SD_LOGS_PERIOD_MIN, SD_LOGS_PERIOD_MAX);
+        new StaticText(line, rect_t{}, STR_INTERVAL, 0, COLOR_THEME_PRIMARY1);
+        auto edit = new NumberEdit(
+            line, rect_t{}, SD_LOGS_PERIOD_MIN, SD_LOGS_PERIOD_MAX,
+            [=]() { return logsPeriodIndex(CFN_PARAM(cfn)); },
+            [=](int32_t value) {
+              CFN_PARAM(cfn) = logsPeriodParam(value);
+              SET_DIRTY();
+            });
         edit->setDefault(SD_LOGS_PERIOD_DEFAULT);         // set default period for DEF button
         edit->setDisplayHandler(
             [=](int32_t value) {
-              return formatNumberAsString(CFN_PARAM(cfn), PREC1, 0, nullptr, "s");
+              return getLogsPeriodString(logsPeriodParam(value));
             });
         break;
       }
@@ -635,7 +650,7 @@ class SpecialFunctionButton : public Button
         break;
 
       case FUNC_LOGS:
-        strcat(s, formatNumberAsString(CFN_PARAM(cfn), PREC1, 0, nullptr, "s").c_str());
+        strcat(s, getLogsPeriodString(CFN_PARAM(cfn)).c_str());
         break;
 
       case FUNC_ADJUST_GVAR:
@@ -258,6 +258,25 @@ void DebugViewPage::build(FormWindow* window)
       line, rect_t{}, [] { return DURATION_MS_PREC2(maxMixerDuration); },
       PREC2 | COLOR_THEME_PRIMARY1, nullptr, pad_STR_MS.c_str());
 
+  // Mixer cycle percentiles
+#if LCD_H > LCD_W
+  line = form->newLine(&grid);
+  line->padAll(0);
+  line->padLeft(10);
+#endif
+  new DebugInfoNumber<uint16_t>(
+      line, rect_t{0, 0, DBG_B_WIDTH, DBG_B_HEIGHT},
+      [] {
+        return mixerTaskGetLatency(MIXER_LATENCY_CYCLE).getPercentile(990) / 2;
+      },
+      COLOR_THEME_PRIMARY1, STR_P99_US, nullptr);
+  new DebugInfoNumber<uint16_t>(
+      line, rect_t{0, 0, DBG_B_WIDTH, DBG_B_HEIGHT},
+      [] {
+        return mixerTaskGetLatency(MIXER_LATENCY_CYCLE).getPercentile(999) / 2;
+      },
+      COLOR_THEME_PRIMARY1, STR_P999_US, nullptr);
+
   line = form->newLine(&grid);
   line->padAll(2);
 
@@ -387,6 +406,7 @@ void DebugViewPage::build(FormWindow* window)
   auto btn = new TextButton(line, rect_t{0, 0, 0, 24}, STR_MENUTORESET,
                             [=]() -> uint8_t {
                               maxMixerDuration = 0;
+                              mixerTaskResetLatencies();
 #if defined(LUA)
                               maxLuaInterval = 0;
                               maxLuaDuration = 0;
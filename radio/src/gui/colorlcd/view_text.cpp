@@ -62,7 +62,7 @@ void ViewTextWindow::extractNameSansExt()
       getFileExtension(name.c_str(), 0, 0, &nameLength, &extLength);
   extension = std::string(ext);
 
-  openFromEnd = !strcmp(ext, LOGS_EXT);
+  openFromEnd = !strcmp(ext, CSV_EXT);
 }
 
 bool ViewTextWindow::openFile()
@@ -21,6 +21,7 @@
 
 #include "opentx.h"
 #include "widgets_container_impl.h"
+#include "mixer_outputs.h"
 
 #define RECT_BORDER 1
 #define ROW_HEIGHT 17
@@ -67,7 +68,7 @@ class OutputsWidget : public Widget
 
     for (uint8_t curChan = firstChan;
          curChan < lastChan && curChan <= MAX_OUTPUT_CHANNELS; curChan++) {
-      const int16_t chanVal = calcRESXto100(channelOutputs[curChan - 1]);
+      const int16_t chanVal = calcRESXto100(mixerOutputs().channels[curChan - 1]);
       const uint16_t rowTop = y + (curChan - firstChan) * rowH;
       const uint16_t barTop = rowTop + RECT_BORDER;
       const uint16_t fillW = divRoundClosest(
@@ -72,8 +72,8 @@ void insertExpo(uint8_t idx)
   expo->mode = 3; // pos+neg
   expo->chn = s_currCh - 1;
   expo->weight = 100;
-  mixerTaskStart();
   storageDirty(EE_MODEL);
+  mixerTaskStart();
 }
 
 void copyExpo(uint8_t idx)
@@ -81,8 +81,8 @@ void copyExpo(uint8_t idx)
   mixerTaskStop();
   ExpoData * expo = expoAddress(idx);
   memmove(expo+1, expo, (MAX_EXPOS-(idx+1))*sizeof(ExpoData));
-  mixerTaskStart();
   storageDirty(EE_MODEL);
+  mixerTaskStart();
 }
 
 bool swapExpos(uint8_t & idx, uint8_t up)
@@ -121,6 +121,7 @@ bool swapExpos(uint8_t & idx, uint8_t up)
   
   mixerTaskStop();
   memswap(x, y, sizeof(ExpoData));
+  storageDirty(EE_MODEL);
   mixerTaskStart();
   
   idx = tgt_idx;
@@ -137,8 +138,8 @@ void deleteExpo(uint8_t idx)
   if (!isInputAvailable(input)) {
     memclear(&g_model.inputNames[input], LEN_INPUT_NAME);
   }
-  mixerTaskStart();
   storageDirty(EE_MODEL);
+  mixerTaskStart();
 }
 
 void onExposMenu(const char * result)
@@ -384,7 +385,7 @@ void menuModelExposAll(event_t event)
   // Value
   uint8_t index = expoAddress(s_currIdx)->chn;
   if (!s_currCh) {
-    lcdDrawNumber(127, 2, calcRESXto1000(anas[index]), PREC1|TINSIZE|RIGHT);
+    lcdDrawNumber(127, 2, calcRESXto1000(getValue(MIXSRC_FIRST_INPUT + index)), PREC1|TINSIZE|RIGHT);
   }
 #endif
   
@@ -393,7 +394,7 @@ void menuModelExposAll(event_t event)
 #if LCD_DEPTH > 1
   // Gauge
   if (!s_currCh) {
-    drawGauge(127, 1, 58, 6, anas[index], 1024);
+    drawGauge(127, 1, 58, 6, getValue(MIXSRC_FIRST_INPUT + index), 1024);
   }
 #endif
   
@@ -23,6 +23,7 @@
 #include "tasks/mixer_task.h"
 #include "hal/adc_driver.h"
 #include "input_mapping.h"
+#include "mixer_plan.h"
 
 #define _STR_MAX(x)                     "/" #x
 #define STR_MAX(x)                     _STR_MAX(x)
@@ -56,8 +57,8 @@ void deleteMix(uint8_t idx)
   MixData * mix = mixAddress(idx);
   memmove(mix, mix+1, (MAX_MIXERS-(idx+1))*sizeof(MixData));
   memclear(&g_model.mixData[MAX_MIXERS-1], sizeof(MixData));
-  mixerTaskStart();
   storageDirty(EE_MODEL);
+  mixerTaskStart();
 }
 
 void insertMix(uint8_t idx)
@@ -79,8 +80,8 @@ void insertMix(uint8_t idx)
     }
   }
   mix->weight = 100;
-  mixerTaskStart();
   storageDirty(EE_MODEL);
+  mixerTaskStart();
 }
 
 void copyMix(uint8_t idx)
@@ -88,8 +89,8 @@ void copyMix(uint8_t idx)
   mixerTaskStop();
   MixData * mix = mixAddress(idx);
   memmove(mix+1, mix, (MAX_MIXERS-(idx+1))*sizeof(MixData));
-  mixerTaskStart();
   storageDirty(EE_MODEL);
+  mixerTaskStart();
 }
 
 bool swapMixes(uint8_t & idx, uint8_t up)
@@ -129,6 +130,7 @@ bool swapMixes(uint8_t & idx, uint8_t up)
 
   mixerTaskStop();
   memswap(x, y, sizeof(MixData));
+  storageDirty(EE_MODEL);
   mixerTaskStart();
 
   idx = tgt_idx;
@@ -446,7 +448,8 @@ void menuModelMixAll(event_t event)
 
           if (mixCnt > 0) lcdDrawTextAtIndex(FW, y, STR_VMLTPX2, md->mltpx, 0);
 
-          drawSource(MIX_LINE_SRC_POS, y, md->srcRaw, 0);
+          // blink the channels read from a previous cycle (channels loop)
+          drawSource(MIX_LINE_SRC_POS, y, md->srcRaw, isMixInChannelLoop(i) ? BLINK : 0);
 
           if (mixCnt == 0 && md->mltpx == 1) {
             lcdDrawText(MIX_LINE_WEIGHT_POS, y, "MULT!", RIGHT | attr | (isMixActive(i) ? BOLD : 0));
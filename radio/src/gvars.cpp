@@ -24,7 +24,7 @@
 uint8_t gvarDisplayTimer = 0;
 uint8_t gvarLastChanged = 0;
 
-uint8_t getGVarFlightMode(uint8_t fm, uint8_t gv) // TODO change params order to be consistent!
+static uint8_t resolveGVarFlightMode(uint8_t fm, uint8_t gv)
 {
   for (uint8_t i=0; i<MAX_FLIGHT_MODES; i++) {
     if (fm == 0) return 0;
@@ -37,6 +37,54 @@ uint8_t getGVarFlightMode(uint8_t fm, uint8_t gv) // TODO change params order to
   return 0;
 }
 
+// GVars resolved for each flight mode
+//
+// The flight modes inheritance chains are walked once per model change
+// instead of on each GVar reference of the mixer. The values changed by
+// setGVarValue() (special functions, trims, Lua) are updated in place, they
+// do not change storageRevision.
+struct GVarCache {
+  uint16_t revision;                                // storageRevision the cache was built from
+  uint8_t flightMode[MAX_FLIGHT_MODES][MAX_GVARS];  // flight mode holding the value
+  int16_t resolved[MAX_FLIGHT_MODES][MAX_GVARS];
+};
+
+static GVarCache gvarCache;
+
+static void gvarCacheUpdate()
+{
+  if (gvarCache.revision == storageRevision)
+    return;
+
+  for (uint8_t fm = 0; fm < MAX_FLIGHT_MODES; fm++) {
+    for (uint8_t gv = 0; gv < MAX_GVARS; gv++) {
+      uint8_t owner = resolveGVarFlightMode(fm, gv);
+      gvarCache.flightMode[fm][gv] = owner;
+      gvarCache.resolved[fm][gv] = GVAR_VALUE(gv, owner);
+    }
+  }
+
+  gvarCache.revision = storageRevision;
+}
+
+uint8_t getGVarFlightMode(uint8_t fm, uint8_t gv) // TODO change params order to be consistent!
+{
+  if (fm >= MAX_FLIGHT_MODES || gv >= MAX_GVARS)
+    return resolveGVarFlightMode(fm, gv);
+
+  gvarCacheUpdate();
+  return gvarCache.flightMode[fm][gv];
+}
+
+static int16_t getResolvedGVar(uint8_t gv, uint8_t fm)
+{
+  if (fm >= MAX_FLIGHT_MODES)
+    return GVAR_VALUE(gv, resolveGVarFlightMode(fm, gv));
+
+  gvarCacheUpdate();
+  return gvarCache.resolved[fm][gv];
+}
+
 int16_t getGVarValue(int8_t gv, int8_t fm)
 {
   int8_t mul = 1;
@@ -44,7 +92,7 @@ int16_t getGVarValue(int8_t gv, int8_t fm)
     gv = -1-gv;
     mul = -1;
   }
-  return GVAR_VALUE(gv, getGVarFlightMode(fm, gv)) * mul;
+  return getResolvedGVar(gv, fm) * mul;
 }
 
 int32_t getGVarValuePrec1(int8_t gv, int8_t fm)
@@ -54,14 +102,22 @@ int32_t getGVarValuePrec1(int8_t gv, int8_t fm)
   if (gv < 0) {
     mul = -mul;
   }
-  return GVAR_VALUE(idx, getGVarFlightMode(fm, idx)) * mul;
+  return getResolvedGVar(idx, fm) * mul;
 }
 
 void setGVarValue(uint8_t gv, int16_t value, int8_t fm)
 {
   fm = getGVarFlightMode(fm, gv);
   if (GVAR_VALUE(gv, fm) != value) {
+    bool cached = (gvarCache.revision == storageRevision);
     SET_GVAR_VALUE(gv, fm, value);
+    if (cached) {
+      // the value is not an inheritance link, the flight modes chains are unchanged
+      for (uint8_t i = 0; i < MAX_FLIGHT_MODES; i++) {
+        if (gvarCache.flightMode[i][gv] == (uint8_t)fm)
+          gvarCache.resolved[i][gv] = value;
+      }
+    }
   }
 }
 
@@ -30,6 +30,7 @@ const etx_hal_adc_driver_t* _hal_adc_driver = nullptr;
 const etx_hal_adc_inputs_t* _hal_adc_inputs = nullptr;
 
 static uint16_t adcValues[MAX_ANALOG_INPUTS] __DMA;
+static uint16_t adcSampleTime = 0;
 
 bool adcInit(const etx_hal_adc_driver_t* driver)
 {
@@ -59,8 +60,14 @@ static bool adcSingleRead()
   return true;
 }
 
+uint16_t adcGetSampleTime()
+{
+  return adcSampleTime;
+}
+
 bool adcRead()
 {
+  adcSampleTime = getTmr2MHz();
   adcSingleRead();
   
   // TODO: this hack needs to go away...
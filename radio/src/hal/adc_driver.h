@@ -84,6 +84,7 @@ bool adcInit(const etx_hal_adc_driver_t* driver);
 // void adcDeInit();
 
 bool     adcRead();
+uint16_t adcGetSampleTime();  // getTmr2MHz() at the start of the last conversion
 uint16_t getBatteryVoltage();
 uint16_t getRTCBatteryVoltage();
 uint16_t getAnalogValue(uint8_t index);
@@ -22,6 +22,7 @@
 #pragma once
 
 #include <stdint.h>
+#include "serial_driver.h"
 
 enum ChannelsProtocols {
   PROTOCOL_CHANNELS_UNINITIALIZED,
@@ -58,4 +59,14 @@ struct etx_proto_driver_t {
 
     // Process input data byte (telemetry)
     void (*processData)(void* context, uint8_t data, uint8_t* buffer, uint8_t* len);
+
+    // Process input data bytes (telemetry, optional: processData() is
+    // called for each byte otherwise)
+    void (*processBuffer)(void* context, const uint8_t* data, uint32_t size,
+                          uint8_t* buffer, uint8_t* len);
+
+    // Process a frame delimited by the serial driver (telemetry, optional),
+    // buffer holds the bytes of a frame split across several of them
+    void (*processFrame)(void* context, const etx_serial_frame_t* frame,
+                         uint8_t* buffer, uint8_t* len);
 };
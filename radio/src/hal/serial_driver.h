@@ -57,6 +57,15 @@ struct etx_serial_callbacks_t {
   void (*on_error)();
 };
 
+// Frame received between 2 idle lines, as (at most 2) contiguous spans of
+// the driver RX buffer: the second one is only used when the frame wraps
+// around the end of the buffer
+typedef struct {
+  const uint8_t* data[2];
+  uint32_t len[2];
+  uint16_t time;  // getTmr2MHz() at the idle line ending the frame
+} etx_serial_frame_t;
+
 enum SerialHWOption {
   ETX_HWOption_OVER8,  // oversampling by 8
   ETX_HWOption_ONEBIT, // one-bit sampling
@@ -88,6 +97,18 @@ typedef struct {
   // Fetch next available byte from internal buffer
   int (*getByte)(void* ctx, uint8_t* data);
 
+  // Fetch up to max_len available bytes from internal buffer,
+  // returns the number of bytes copied
+  int (*getBytes)(void* ctx, uint8_t* data, uint32_t max_len);
+
+  // Delimit received frames with the idle line (replaces the idle callback)
+  void (*setFrameMode)(void* ctx, uint8_t enabled);
+
+  // Fetch the next complete frame without copying it, returns its length
+  // (0 if none, -1 if the frame mode is not enabled). The frame is consumed:
+  // its spans are valid until the driver receives a buffer length of new data.
+  int (*getFrame)(void* ctx, etx_serial_frame_t* frame);
+
   // Fetch a byte by its index from the end of the buffer
   int (*getLastByte)(void* ctx, uint32_t idx, uint8_t* data);
   
@@ -0,0 +1,240 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "input_plan.h"
+#include "switches.h"
+#include "hal/trainer_driver.h"
+
+InputPlan inputPlan;
+volatile uint32_t inputsRequested = 0;
+static volatile bool inputsRequestsReset = false;
+
+static bool isGVarRef(int16_t value)
+{
+#if defined(GVARS)
+  return GV_IS_GV_VALUE(value, -100, 100);
+#else
+  return false;
+#endif
+}
+
+static uint32_t inputMask(int32_t source)
+{
+  if (source >= MIXSRC_FIRST_INPUT && source <= MIXSRC_LAST_INPUT)
+    return (uint32_t)1 << (source - MIXSRC_FIRST_INPUT);
+  return 0;
+}
+
+static uint32_t getFunctionsInputs(const CustomFunctionData * functions)
+{
+  uint32_t result = 0;
+  for (uint8_t i = 0; i < MAX_SPECIAL_FUNCTIONS; i++) {
+    // the parameter is not always a source, a few more inputs evaluated is harmless
+    result |= inputMask(CFN_PARAM(&functions[i]));
+  }
+  return result;
+}
+
+// inputs read by the model itself
+static uint32_t getModelInputs()
+{
+  uint32_t result = 0;
+
+  for (uint8_t i = 0; i < MAX_MIXERS; i++) {
+    result |= inputMask(mixAddress(i)->srcRaw);
+  }
+
+  for (uint8_t i = 0; i < MAX_LOGICAL_SWITCHES; i++) {
+    LogicalSwitchData * ls = lswAddress(i);
+    if (ls->func) {
+      result |= inputMask(ls->v1) | inputMask(ls->v2);
+    }
+  }
+
+  result |= getFunctionsInputs(g_model.customFn);
+  result |= getFunctionsInputs(g_eeGeneral.customFn);
+
+#if defined(HELI)
+  result |= inputMask(g_model.swashR.elevatorSource);
+  result |= inputMask(g_model.swashR.aileronSource);
+  result |= inputMask(g_model.swashR.collectiveSource);
+#endif
+
+  return result;
+}
+
+static void inputPlanCompileItem(InputPlanItem & item, uint8_t index)
+{
+  ExpoData * ed = expoAddress(index);
+
+  item.ed = ed;
+  item.index = index;
+  item.srcRaw = ed->srcRaw;
+  item.chn = ed->chn;
+  item.flags = 0;
+
+  if (ed->flightModes != 0 || ed->swtch)
+    item.flags |= INPUT_PLAN_CONDITION;
+
+  if (ed->srcRaw >= MIXSRC_FIRST_TRAINER && ed->srcRaw <= MIXSRC_LAST_TRAINER)
+    item.flags |= INPUT_PLAN_SRC_TRAINER;
+
+  if (ed->srcRaw >= MIXSRC_FIRST_TELEM && ed->scale > 0)
+    item.flags |= INPUT_PLAN_TELEM_SCALE;
+
+  if (ed->curve.value)
+    item.flags |= INPUT_PLAN_CURVE;
+
+  item.weight = 0;
+  if (isGVarRef(ed->weight))
+    item.flags |= INPUT_PLAN_WEIGHT_GVAR;
+  else
+    item.weight = GET_GVAR_PREC1(ed->weight, -100, 100, 0);
+
+  item.offset = 0;
+  if (isGVarRef(ed->offset)) {
+    item.flags |= INPUT_PLAN_OFFSET_GVAR;
+  }
+  else {
+    int32_t offset = GET_GVAR_PREC1(ed->offset, -100, 100, 0);
+    if (offset) item.offset = divRoundClosest(calc100toRESX(offset), 10);
+  }
+
+  if (ed->trimSource < TRIM_ON)
+    item.trimOrigin = -ed->trimSource - 1;
+  else if (ed->trimSource == TRIM_ON && ed->srcRaw >= MIXSRC_FIRST_STICK &&
+           ed->srcRaw <= MIXSRC_LAST_STICK)
+    item.trimOrigin = ed->srcRaw - MIXSRC_FIRST_STICK;
+  else
+    item.trimOrigin = -1;
+}
+
+void inputPlanCompile()
+{
+  uint8_t count = 0;
+
+  if (inputsRequestsReset) {
+    inputsRequestsReset = false;
+    inputPlan.requested = 0;
+  }
+
+  // the inputs requested stay evaluated until the next model load
+  inputPlan.requested |= __sync_fetch_and_and(&inputsRequested, 0);
+  uint32_t inputs = getModelInputs() | inputPlan.requested;
+
+  for (uint8_t i = 0; i < MAX_EXPOS; i++) {
+    // lines which are not evaluated anymore should not look active
+    swOn[i].activeExpo = false;
+  }
+
+  for (uint8_t i = 0; i < MAX_EXPOS; i++) {
+    ExpoData * ed = expoAddress(i);
+    if (!EXPO_VALID(ed))
+      break;
+    if (inputs & ((uint32_t)1 << ed->chn))
+      inputPlanCompileItem(inputPlan.items[count++], i);
+  }
+
+  inputPlan.count = count;
+  inputPlan.inputs = inputs;
+  inputPlan.revision = storageRevision;
+}
+
+void applyInputPlan(int16_t * anas, uint8_t mode)
+{
+  uint32_t done = 0;
+
+  inputPlanUpdate();
+
+  for (uint8_t p = 0; p < inputPlan.count; p++) {
+    const InputPlanItem & item = inputPlan.items[p];
+    uint32_t mask = (uint32_t)1 << item.chn;
+    ExpoData * ed = item.ed;
+
+    if (mode == e_perout_mode_normal)
+      swOn[item.index].activeExpo = false;
+    if (done & mask)
+      continue;
+    if ((item.flags & INPUT_PLAN_CONDITION) && (ed->flightModes & (1 << mixerCurrentFlightMode)))
+      continue;
+    if ((item.flags & INPUT_PLAN_SRC_TRAINER) && !is_trainer_connected())
+      continue;
+    if ((item.flags & INPUT_PLAN_CONDITION) && !getSwitch(ed->swtch))
+      continue;
+
+    int32_t v = getValue(item.srcRaw);
+    if (item.flags & INPUT_PLAN_TELEM_SCALE) {
+      v = (v * 1024) / convertTelemValue(item.srcRaw - MIXSRC_FIRST_TELEM + 1, ed->scale);
+    }
+    v = limit<int32_t>(-1024, v, 1024);
+
+    if (!EXPO_MODE_ENABLE(ed, v))
+      continue;
+
+    if (mode == e_perout_mode_normal)
+      swOn[item.index].activeExpo = true;
+    done |= mask;
+
+    //========== CURVE=================
+    if (item.flags & INPUT_PLAN_CURVE) {
+      v = applyCurve(v, ed->curve);
+    }
+
+    //========== WEIGHT ===============
+    int32_t weight = item.weight;
+    if (item.flags & INPUT_PLAN_WEIGHT_GVAR)
+      weight = GET_GVAR_PREC1(ed->weight, -100, 100, mixerCurrentFlightMode);
+    v = divRoundClosest((int32_t)v * weight, 1000);
+
+    //========== OFFSET ===============
+    if (item.flags & INPUT_PLAN_OFFSET_GVAR) {
+      int32_t offset = GET_GVAR_PREC1(ed->offset, -100, 100, mixerCurrentFlightMode);
+      if (offset) v += divRoundClosest(calc100toRESX(offset), 10);
+    }
+    else {
+      v += item.offset;
+    }
+
+    //========== TRIMS ================
+    virtualInputsTrims[item.chn] = item.trimOrigin;
+    anas[item.chn] = v;
+  }
+}
+
+uint32_t inputPlanRequestInputs(uint32_t inputs)
+{
+  uint32_t evaluated = inputPlan.inputs;
+  if (inputs & ~evaluated)
+    __sync_fetch_and_or(&inputsRequested, inputs & ~evaluated);
+  return evaluated;
+}
+
+void inputPlanReset()
+{
+  inputsRequestsReset = true;
+}
+
+bool isExpoActive(uint8_t expo)
+{
+  // the line state is only known when its input is evaluated
+  inputPlanRequest(expoAddress(expo)->chn);
+  return swOn[expo].activeExpo;
+}
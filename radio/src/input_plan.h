@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include "opentx.h"
+
+// The input plan is a pre-decoded copy of the model inputs (expo) table,
+// compiled whenever the model is loaded or edited, like the mix plan. The
+// lines are grouped by input, their weight, offset and trim source are
+// resolved unless they come from a GVar, and only the inputs read by the
+// model (mixes, logical switches, special functions) or through getValue()
+// (screens, Lua, widgets) are evaluated.
+
+enum InputPlanFlags {
+  INPUT_PLAN_CONDITION    = (1 << 0), // flight modes and/or switch condition
+  INPUT_PLAN_SRC_TRAINER  = (1 << 1), // source is a trainer channel
+  INPUT_PLAN_TELEM_SCALE  = (1 << 2), // telemetry source with a scale
+  INPUT_PLAN_CURVE        = (1 << 3), // curve / expo / function
+  INPUT_PLAN_WEIGHT_GVAR  = (1 << 4), // weight resolved at runtime from a GVar
+  INPUT_PLAN_OFFSET_GVAR  = (1 << 5), // offset resolved at runtime from a GVar
+};
+
+struct InputPlanItem {
+  ExpoData * ed;      // input line in g_model
+  mixsrc_t srcRaw;
+  uint8_t flags;
+  uint8_t index;      // input line index
+  uint8_t chn;
+  int8_t trimOrigin;  // virtualInputsTrims[] value when the line is used
+  int16_t weight;     // only without INPUT_PLAN_WEIGHT_GVAR
+  int16_t offset;     // in RESX units, only without INPUT_PLAN_OFFSET_GVAR
+};
+
+struct InputPlan {
+  uint16_t revision;  // storageRevision the plan was compiled from
+  uint8_t count;
+  uint32_t inputs;    // inputs evaluated
+  uint32_t requested; // inputs requested since the model was loaded
+  InputPlanItem items[MAX_EXPOS];
+};
+
+extern InputPlan inputPlan;
+
+// inputs requested (getValue(), anas[] readers) and not yet seen by the
+// mixer task, which fetches and clears them atomically
+extern volatile uint32_t inputsRequested;
+
+// Compile the input plan from the current model
+void inputPlanCompile();
+
+// Compile the input plan if the model changed since the last compilation
+// or if an input not evaluated has been read
+inline void inputPlanUpdate()
+{
+  if (inputPlan.revision != storageRevision || (inputsRequested & ~inputPlan.inputs)) {
+    inputPlanCompile();
+  }
+}
+
+// Evaluate the given inputs from the next mixer cycle (from the next
+// evalInputs() when called from the mixer task) until the next model load,
+// returns the inputs currently evaluated
+uint32_t inputPlanRequestInputs(uint32_t inputs);
+
+inline void inputPlanRequest(uint8_t input)
+{
+  inputPlanRequestInputs((uint32_t)1 << input);
+}
+
+// Forget the inputs requested with the previous model (model load)
+void inputPlanReset();
+
+// Same as applyExpos() for the inputs of the plan
+void applyInputPlan(int16_t * anas, uint8_t mode);
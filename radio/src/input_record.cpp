@@ -0,0 +1,462 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "opentx.h"
+#include "input_record.h"
+
+#if defined(INPUT_RECORD)
+
+#include "fifo.h"
+#include "hal/adc_driver.h"
+#include "hal/switch_driver.h"
+
+// File format (little endian)
+//
+//   InputRecordHeader
+//   frames:
+//     uint16_t size                  frame size, including this field
+//     uint8_t  tick10ms
+//     uint8_t  telemetryStreaming
+//     uint8_t  trainerInputValidityTimer
+//     uint16_t analogs[header.analogs]          raw ADC values
+//     uint8_t  switches[(header.switches + 3) / 4]  2 bits per switch (SwitchHwPos)
+//     uint8_t  trimsCount
+//       { uint8_t flightMode, uint8_t trim, int16_t value } * trimsCount       (changed only)
+//     int16_t  trainer[header.trainerChannels]  only if trainerInputValidityTimer != 0
+//     uint8_t  sensorsCount
+//       { uint8_t sensor, int32_t value, int32_t min, int32_t max, int8_t timeout } * sensorsCount
+//                                                                            (changed only)
+
+#define INPUT_RECORD_VERSION    1
+
+PACK(struct InputRecordHeader {
+  char magic[4];
+  uint8_t version;
+  uint8_t analogs;
+  uint8_t switches;
+  uint8_t trims;
+  uint8_t trainerChannels;
+  uint8_t sensors;
+  char modelName[LEN_MODEL_NAME];
+});
+
+static const char inputRecordMagic[4] = { 'E', 'T', 'X', 'R' };
+
+PACK(struct InputRecordSensor {
+  uint8_t sensor;
+  int32_t value;
+  int32_t valueMin;
+  int32_t valueMax;
+  int8_t timeout;
+});
+
+#define INPUT_RECORD_MAX_FRAME_SIZE                       \
+  (5 + 2 * MAX_ANALOG_INPUTS + (MAX_SWITCHES + 3) / 4 +   \
+   1 + 4 * MAX_FLIGHT_MODES * MAX_TRIMS +                 \
+   2 * MAX_TRAINER_CHANNELS +                             \
+   1 + sizeof(InputRecordSensor) * MAX_TELEMETRY_SENSORS)
+
+static void fillHeader(InputRecordHeader & header)
+{
+  memcpy(header.magic, inputRecordMagic, sizeof(header.magic));
+  header.version = INPUT_RECORD_VERSION;
+  header.analogs = adcGetMaxInputs(ADC_INPUT_ALL);
+  header.switches = switchGetMaxSwitches() + switchGetMaxFctSwitches();
+  header.trims = keysGetMaxTrims();
+  header.trainerChannels = MAX_TRAINER_CHANNELS;
+  header.sensors = MAX_TELEMETRY_SENSORS;
+  memcpy(header.modelName, g_model.header.name, sizeof(header.modelName));
+}
+
+// Recording
+
+static FIL inputRecordFile __DMA;
+static char inputRecordFilename[sizeof(LOGS_PATH) + LEN_MODEL_NAME + 18 + sizeof(INPUT_RECORD_EXT)];
+static Fifo<uint8_t, 2048> inputRecordFifo;
+static volatile bool inputRecordRunning = false;
+static volatile bool inputRecordOverflow = false;
+static const char * inputRecordError = nullptr;
+
+enum InputRecordRequest {
+  INPUT_RECORD_REQUEST_NONE,
+  INPUT_RECORD_REQUEST_START,
+  INPUT_RECORD_REQUEST_STOP,
+};
+
+static volatile uint8_t inputRecordRequest = INPUT_RECORD_REQUEST_NONE;
+
+// last recorded values, only changes are recorded
+static int16_t recordedTrims[MAX_FLIGHT_MODES][MAX_TRIMS];
+static InputRecordSensor recordedSensors[MAX_TELEMETRY_SENSORS];
+
+bool inputRecordActive()
+{
+  return inputRecordRunning;
+}
+
+const char * inputRecordGetFilename()
+{
+  return inputRecordFilename;
+}
+
+const char * inputRecordGetError()
+{
+  return inputRecordError;
+}
+
+void inputRecordRequestStart()
+{
+  inputRecordRequest = INPUT_RECORD_REQUEST_START;
+}
+
+void inputRecordRequestStop()
+{
+  inputRecordRequest = INPUT_RECORD_REQUEST_STOP;
+}
+
+static const char * inputRecordStart()
+{
+  if (inputRecordRunning)
+    return nullptr;
+
+  if (!sdMounted())
+    return STR_NO_SDCARD;
+
+  char * filename = inputRecordFilename;
+  strcpy(filename, STR_LOGS_PATH);
+  const char * error = sdCheckAndCreateDirectory(filename);
+  if (error) {
+    return error;
+  }
+
+  char * tmp = &filename[sizeof(LOGS_PATH) - 1];
+  *tmp++ = '/';
+  tmp = strAppendFilename(tmp, g_model.header.name, LEN_MODEL_NAME);
+#if defined(RTCLOCK)
+  tmp = strAppendDate(tmp, true);
+#endif
+  strcpy(tmp, INPUT_RECORD_EXT);
+
+  FRESULT result = f_open(&inputRecordFile, filename, FA_CREATE_ALWAYS | FA_WRITE);
+  if (result != FR_OK) {
+    return SDCARD_ERROR(result);
+  }
+
+  InputRecordHeader header;
+  fillHeader(header);
+  UINT written;
+  result = f_write(&inputRecordFile, &header, sizeof(header), &written);
+  if (result != FR_OK) {
+    f_close(&inputRecordFile);
+    return SDCARD_ERROR(result);
+  }
+
+  // force the first frame to hold all trims and sensors
+  for (uint8_t fm = 0; fm < MAX_FLIGHT_MODES; fm++) {
+    for (uint8_t i = 0; i < MAX_TRIMS; i++) {
+      recordedTrims[fm][i] = ~g_model.flightModeData[fm].trim[i].value;
+    }
+  }
+  for (uint8_t i = 0; i < MAX_TELEMETRY_SENSORS; i++) {
+    recordedSensors[i].timeout = ~telemetryItems[i].timeout;
+  }
+
+  inputRecordFifo.clear();
+  inputRecordOverflow = false;
+  inputRecordRunning = true;
+
+  return nullptr;
+}
+
+static void inputRecordWrite()
+{
+  uint8_t buffer[128];
+  uint8_t count = 0;
+  uint8_t byte;
+
+  while (inputRecordFifo.pop(byte)) {
+    buffer[count++] = byte;
+    if (count == sizeof(buffer)) {
+      UINT written;
+      f_write(&inputRecordFile, buffer, count, &written);
+      count = 0;
+    }
+  }
+
+  if (count > 0) {
+    UINT written;
+    f_write(&inputRecordFile, buffer, count, &written);
+  }
+}
+
+static void inputRecordStop()
+{
+  if (!inputRecordRunning)
+    return;
+
+  inputRecordRunning = false;
+  inputRecordWrite();
+  f_close(&inputRecordFile);
+}
+
+template <class T>
+static inline uint8_t * writeValue(uint8_t * p, T value)
+{
+  memcpy(p, &value, sizeof(T));
+  return p + sizeof(T);
+}
+
+static uint16_t encodeFrame(uint8_t * frame, uint8_t tick10ms)
+{
+  uint8_t * p = frame + sizeof(uint16_t);
+
+  *p++ = tick10ms;
+  *p++ = telemetryStreaming;
+  *p++ = trainerInputValidityTimer;
+
+  uint8_t analogs = adcGetMaxInputs(ADC_INPUT_ALL);
+  for (uint8_t i = 0; i < analogs; i++) {
+    p = writeValue<uint16_t>(p, getAnalogValue(i));
+  }
+
+  uint8_t switches = switchGetMaxSwitches() + switchGetMaxFctSwitches();
+  for (uint8_t i = 0; i < switches; i += 4) {
+    uint8_t bits = 0;
+    for (uint8_t j = 0; j < 4 && i + j < switches; j++) {
+      bits |= switchGetPosition(i + j) << (2 * j);
+    }
+    *p++ = bits;
+  }
+
+  uint8_t * count = p++;
+  *count = 0;
+  for (uint8_t fm = 0; fm < MAX_FLIGHT_MODES; fm++) {
+    for (uint8_t i = 0; i < keysGetMaxTrims(); i++) {
+      int16_t value = g_model.flightModeData[fm].trim[i].value;
+      if (value != recordedTrims[fm][i]) {
+        recordedTrims[fm][i] = value;
+        *p++ = fm;
+        *p++ = i;
+        p = writeValue<int16_t>(p, value);
+        (*count)++;
+      }
+    }
+  }
+
+  if (trainerInputValidityTimer) {
+    for (uint8_t i = 0; i < MAX_TRAINER_CHANNELS; i++) {
+      p = writeValue<int16_t>(p, trainerInput[i]);
+    }
+  }
+
+  count = p++;
+  *count = 0;
+  for (uint8_t i = 0; i < MAX_TELEMETRY_SENSORS; i++) {
+    const TelemetryItem & item = telemetryItems[i];
+    InputRecordSensor & recorded = recordedSensors[i];
+    if (item.value != recorded.value || item.valueMin != recorded.valueMin ||
+        item.valueMax != recorded.valueMax || item.timeout != recorded.timeout) {
+      recorded.sensor = i;
+      recorded.value = item.value;
+      recorded.valueMin = item.valueMin;
+      recorded.valueMax = item.valueMax;
+      recorded.timeout = item.timeout;
+      memcpy(p, &recorded, sizeof(recorded));
+      p += sizeof(recorded);
+      (*count)++;
+    }
+  }
+
+  uint16_t size = p - frame;
+  writeValue<uint16_t>(frame, size);
+  return size;
+}
+
+void inputRecordFrame(uint8_t tick10ms)
+{
+  if (!inputRecordRunning || inputRecordOverflow)
+    return;
+
+  static uint8_t frame[INPUT_RECORD_MAX_FRAME_SIZE];
+  uint16_t size = encodeFrame(frame, tick10ms);
+
+  if (!inputRecordFifo.hasSpace(size)) {
+    // the SD card is too slow, the record would not be replayable anymore
+    inputRecordOverflow = true;
+    return;
+  }
+
+  for (uint16_t i = 0; i < size; i++) {
+    inputRecordFifo.push(frame[i]);
+  }
+}
+
+void inputRecordFlush()
+{
+  uint8_t request = inputRecordRequest;
+  if (request != INPUT_RECORD_REQUEST_NONE) {
+    inputRecordRequest = INPUT_RECORD_REQUEST_NONE;
+    if (request == INPUT_RECORD_REQUEST_START)
+      inputRecordError = inputRecordStart();
+    else
+      inputRecordStop();
+  }
+
+  if (!inputRecordRunning)
+    return;
+
+  inputRecordWrite();
+
+  if (inputRecordOverflow) {
+    TRACE("Input record overflow, record stopped");
+    inputRecordRunning = false;
+    f_close(&inputRecordFile);
+  }
+}
+
+#endif // INPUT_RECORD
+
+#if defined(SIMU)
+
+#include <stdio.h>
+
+static FILE * inputReplayFile = nullptr;
+static InputRecordHeader inputReplayHeader;
+static uint16_t inputReplayAnalogs[MAX_ANALOG_INPUTS];
+
+bool inputReplayActive()
+{
+  return inputReplayFile != nullptr;
+}
+
+const char * inputReplayOpen(const char * path)
+{
+  inputReplayClose();
+
+  inputReplayFile = fopen(path, "rb");
+  if (!inputReplayFile) {
+    return "cannot open file";
+  }
+
+  InputRecordHeader & header = inputReplayHeader;
+  InputRecordHeader expected;
+  fillHeader(expected);
+
+  if (fread(&header, sizeof(header), 1, inputReplayFile) != 1 ||
+      memcmp(header.magic, inputRecordMagic, sizeof(header.magic)) ||
+      header.version != INPUT_RECORD_VERSION) {
+    inputReplayClose();
+    return "invalid record file";
+  }
+
+  if (header.analogs != expected.analogs || header.switches != expected.switches ||
+      header.trims != expected.trims || header.trainerChannels != expected.trainerChannels ||
+      header.sensors != expected.sensors) {
+    inputReplayClose();
+    return "record from another radio type";
+  }
+
+  return nullptr;
+}
+
+void inputReplayClose()
+{
+  if (inputReplayFile) {
+    fclose(inputReplayFile);
+    inputReplayFile = nullptr;
+  }
+}
+
+template <class T>
+static inline const uint8_t * readValue(const uint8_t * p, T & value)
+{
+  memcpy(&value, p, sizeof(T));
+  return p + sizeof(T);
+}
+
+bool inputReplayNextFrame()
+{
+  if (!inputReplayFile)
+    return false;
+
+  static uint8_t frame[INPUT_RECORD_MAX_FRAME_SIZE];
+  uint16_t size;
+  if (fread(&size, sizeof(size), 1, inputReplayFile) != 1 || size < sizeof(size) ||
+      size > sizeof(frame) ||
+      fread(frame + sizeof(size), size - sizeof(size), 1, inputReplayFile) != 1) {
+    return false;
+  }
+
+  const InputRecordHeader & header = inputReplayHeader;
+  const uint8_t * p = frame + sizeof(size);
+
+  g_tmr10ms += *p++;
+  telemetryStreaming = *p++;
+  trainerInputValidityTimer = *p++;
+
+  for (uint8_t i = 0; i < header.analogs; i++) {
+    p = readValue(p, inputReplayAnalogs[i]);
+  }
+
+  for (uint8_t i = 0; i < header.switches; i += 4) {
+    uint8_t bits = *p++;
+    for (uint8_t j = 0; j < 4 && i + j < header.switches; j++) {
+      simuSetSwitch(i + j, ((bits >> (2 * j)) & 0x03) - 1);
+    }
+  }
+
+  uint8_t count = *p++;
+  while (count--) {
+    uint8_t fm = *p++;
+    uint8_t idx = *p++;
+    int16_t value;
+    p = readValue(p, value);
+    g_model.flightModeData[fm].trim[idx].value = value;
+  }
+
+  if (trainerInputValidityTimer) {
+    for (uint8_t i = 0; i < header.trainerChannels; i++) {
+      p = readValue(p, trainerInput[i]);
+    }
+  }
+
+  count = *p++;
+  while (count--) {
+    InputRecordSensor sensor;
+    p = readValue(p, sensor);
+    TelemetryItem & item = telemetryItems[sensor.sensor];
+    item.value = sensor.value;
+    item.valueMin = sensor.valueMin;
+    item.valueMax = sensor.valueMax;
+    item.timeout = sensor.timeout;
+  }
+
+  return true;
+}
+
+void inputReplayGetAnalogs()
+{
+  for (uint8_t i = 0; i < inputReplayHeader.analogs; i++) {
+    setAnalogValue(i, inputReplayAnalogs[i]);
+  }
+}
+
+#endif // SIMU
@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <inttypes.h>
+
+// Mixer inputs record / replay
+//
+// The inputs of each mixer cycle (raw analogs, switches positions, trims,
+// trainer inputs, telemetry values and 10ms ticks) are recorded into a
+// binary file on the SD card. The file can be replayed in the simulator
+// (or any SIMU binary) through doMixerCalculations() to reproduce the same
+// channels outputs from the same model.
+//
+// Recording is only built into the firmware with INPUT_RECORD=ON, it is
+// always available in SIMU builds.
+
+#if defined(SIMU) && !defined(INPUT_RECORD)
+  #define INPUT_RECORD
+#endif
+
+#define INPUT_RECORD_EXT        ".rec"
+
+#if defined(INPUT_RECORD)
+// Radio side
+//
+// Only the main task opens, writes and closes the record file: the other
+// tasks (CLI) request the start / stop, which is handled by the next
+// inputRecordFlush().
+void inputRecordRequestStart();
+void inputRecordRequestStop();
+bool inputRecordActive();
+const char * inputRecordGetFilename();    // last record file
+const char * inputRecordGetError();       // why the last record could not start
+void inputRecordFrame(uint8_t tick10ms);  // mixer task, after inputs are read
+void inputRecordFlush();                  // main task, writes to the SD card
+#endif
+
+#if defined(SIMU)
+// Simulator side
+const char * inputReplayOpen(const char * path);
+void inputReplayClose();
+bool inputReplayActive();
+// apply the next recorded frame inputs, returns false at the end of the file
+bool inputReplayNextFrame();
+// set the recorded analogs (called from the simu ADC driver)
+void inputReplayGetAnalogs();
+#endif
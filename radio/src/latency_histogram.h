@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <inttypes.h>
+#include <string.h>
+
+// Histogram of durations measured with getTmr2MHz() (0.5us steps)
+//
+// Bucket 0 holds the 0 durations, bucket n the durations in [2^(n-1), 2^n[,
+// so adding a sample is only a few instructions and percentiles are known
+// within a factor 2, which is enough to see the jitter.
+#define LATENCY_HISTOGRAM_BUCKETS   17
+
+class LatencyHistogram
+{
+  public:
+    void reset()
+    {
+      memset(buckets, 0, sizeof(buckets));
+      count = 0;
+      max = 0;
+    }
+
+    void add(uint16_t duration)
+    {
+      buckets[bucketIndex(duration)]++;
+      count++;
+      if (duration > max)
+        max = duration;
+    }
+
+    uint32_t getCount() const
+    {
+      return count;
+    }
+
+    uint16_t getMax() const
+    {
+      return max;
+    }
+
+    uint32_t getBucket(uint8_t index) const
+    {
+      return buckets[index];
+    }
+
+    // upper bound of the duration of the given per mille of the samples
+    // (500 = median, 990 = p99, 999 = p999)
+    uint16_t getPercentile(uint16_t perMille) const
+    {
+      uint32_t threshold = ((uint64_t)count * perMille + 999) / 1000;
+      uint32_t total = 0;
+      for (uint8_t i = 0; i < LATENCY_HISTOGRAM_BUCKETS; i++) {
+        total += buckets[i];
+        if (total >= threshold) {
+          uint16_t bound = bucketMax(i);
+          return bound < max ? bound : max;
+        }
+      }
+      return max;
+    }
+
+    static uint8_t bucketIndex(uint16_t duration)
+    {
+      return duration ? 32 - __builtin_clz(duration) : 0;
+    }
+
+    static uint16_t bucketMax(uint8_t index)
+    {
+      return (1u << index) - 1;
+    }
+
+  protected:
+    uint32_t buckets[LATENCY_HISTOGRAM_BUCKETS];
+    uint32_t count;
+    uint16_t max;
+};
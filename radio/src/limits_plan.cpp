@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "limits_plan.h"
+#include "hal/trainer_driver.h"
+
+LimitsPlan limitsPlan;
+
+static bool isGVarRef(int16_t value, int16_t min, int16_t max)
+{
+#if defined(GVARS)
+  return GV_IS_GV_VALUE(value, min, max);
+#else
+  return false;
+#endif
+}
+
+// same computations as in applyLimits(), with the current flight mode
+static void limitsPlanResolve(uint8_t channel)
+{
+  LimitData * lim = limitAddress(channel);
+
+  int16_t ofs   = LIMIT_OFS_RESX(lim);
+  int16_t lim_p = LIMIT_MAX_RESX(lim);
+  int16_t lim_n = LIMIT_MIN_RESX(lim);
+
+  if (ofs > lim_p) ofs = lim_p;
+  if (ofs < lim_n) ofs = lim_n;
+
+  limitsPlan.ofs[channel] = ofs;
+  limitsPlan.max[channel] = lim_p;
+  limitsPlan.min[channel] = lim_n;
+
+#if defined(PPM_LIMITS_SYMETRICAL)
+  if (lim->symetrical) {
+    limitsPlan.scalePos[channel] = lim_p;
+    limitsPlan.scaleNeg[channel] = -lim_n;
+  }
+  else
+#endif
+  {
+    limitsPlan.scalePos[channel] = lim_p - ofs;
+    limitsPlan.scaleNeg[channel] = -lim_n + ofs;
+  }
+
+  limitsPlan.sign[channel] = lim->revert ? -1 : 1;
+}
+
+void limitsPlanCompile()
+{
+  uint8_t special = 0;
+
+  for (uint8_t i = 0; i < MAX_OUTPUT_CHANNELS; i++) {
+    LimitData * lim = limitAddress(i);
+    uint8_t flags = 0;
+
+    if (lim->curve)
+      flags |= LIMITS_PLAN_CURVE;
+
+    if (isGVarRef(lim->offset, -LIMIT_STD_MAX, LIMIT_STD_MAX) ||
+        isGVarRef(lim->max, -GV_RANGELARGE, GV_RANGELARGE) ||
+        isGVarRef(lim->min, -GV_RANGELARGE, GV_RANGELARGE))
+      flags |= LIMITS_PLAN_GVAR;
+
+    limitsPlan.flags[i] = flags;
+    if (flags)
+      limitsPlan.specialChannels[special++] = i;
+
+    limitsPlanResolve(i);
+  }
+
+  limitsPlan.special = special;
+  limitsPlan.revision = storageRevision;
+}
+
+void applyLimitsPlan(const int32_t * values, int16_t * outputs)
+{
+  int32_t input[MAX_OUTPUT_CHANNELS];
+  int32_t result[MAX_OUTPUT_CHANNELS];
+
+  limitsPlanUpdate();
+
+  memcpy(input, values, sizeof(input));
+
+  for (uint8_t i = 0; i < limitsPlan.special; i++) {
+    uint8_t ch = limitsPlan.specialChannels[i];
+    uint8_t flags = limitsPlan.flags[ch];
+    if (flags & LIMITS_PLAN_GVAR) {
+      limitsPlanResolve(ch);
+    }
+    if (flags & LIMITS_PLAN_CURVE) {
+      int8_t curve = limitAddress(ch)->curve;
+      if (curve > 0)
+        input[ch] = 256 * applyCustomCurve(input[ch] / 256, curve - 1);
+      else
+        input[ch] = 256 * applyCustomCurve(-input[ch] / 256, -curve - 1);
+    }
+  }
+
+  // No branches and no early exit in this loop, so that it can be vectorized.
+  // A 0 value ends up with the offset, as in applyLimits()
+  for (uint8_t i = 0; i < MAX_OUTPUT_CHANNELS; i++) {
+    int32_t value = limit<int32_t>(-RESXl * 256, input[i], RESXl * 256);
+    value *= (value > 0 ? limitsPlan.scalePos[i] : limitsPlan.scaleNeg[i]);
+    // Round away from 0
+    int32_t ofs = limitsPlan.ofs[i] + ((value + (value < 0 ? (1 << 17) - 1 : (1 << 17))) >> 18);
+    ofs = ofs > limitsPlan.max[i] ? limitsPlan.max[i] : ofs;
+    ofs = ofs < limitsPlan.min[i] ? limitsPlan.min[i] : ofs;
+    result[i] = ofs * limitsPlan.sign[i];
+  }
+
+  if (isFunctionActive(FUNCTION_TRAINER_CHANNELS) && is_trainer_connected()) {
+    for (uint8_t i = 0; i < MAX_TRAINER_CHANNELS && i < MAX_OUTPUT_CHANNELS; i++) {
+      result[i] = trainerInput[i] * 2;
+    }
+  }
+
+#if defined(OVERRIDE_CHANNEL_FUNCTION)
+  for (uint8_t i = 0; i < MAX_OUTPUT_CHANNELS; i++) {
+    if (safetyCh[i] != OVERRIDE_CHANNEL_UNDEFINED) {
+      result[i] = calc100toRESX(safetyCh[i]);
+    }
+  }
+#endif
+
+  for (uint8_t i = 0; i < MAX_OUTPUT_CHANNELS; i++) {
+    outputs[i] = result[i];
+  }
+}
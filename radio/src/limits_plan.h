@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include "opentx.h"
+
+// The limits plan holds the outputs (min / max / offset / invert) of the
+// model in a structure of arrays, resolved once per model edit. The output
+// stage of evalMixes() then runs over all channels with the same branchless
+// arithmetic, which the compiler is able to vectorize, and only the channels
+// with a curve, a GVar or an override go through the per channel code.
+
+enum LimitsPlanFlags {
+  LIMITS_PLAN_CURVE = (1 << 0), // output curve
+  LIMITS_PLAN_GVAR  = (1 << 1), // min, max or offset resolved at runtime from a GVar
+};
+
+struct LimitsPlan {
+  uint16_t revision;  // storageRevision the plan was compiled from
+  uint8_t special;    // number of channels with flags
+  uint8_t specialChannels[MAX_OUTPUT_CHANNELS];
+  uint8_t flags[MAX_OUTPUT_CHANNELS];
+  int32_t ofs[MAX_OUTPUT_CHANNELS];     // offset, already limited to [min, max]
+  int32_t max[MAX_OUTPUT_CHANNELS];
+  int32_t min[MAX_OUTPUT_CHANNELS];
+  int32_t scalePos[MAX_OUTPUT_CHANNELS]; // multiplier of the positive values
+  int32_t scaleNeg[MAX_OUTPUT_CHANNELS]; // multiplier of the negative values
+  int32_t sign[MAX_OUTPUT_CHANNELS];     // -1 when the output is inverted
+};
+
+extern LimitsPlan limitsPlan;
+
+// Compile the limits plan from the current model
+void limitsPlanCompile();
+
+// Compile the limits plan if the model changed since the last compilation
+inline void limitsPlanUpdate()
+{
+  if (limitsPlan.revision != storageRevision) {
+    limitsPlanCompile();
+  }
+}
+
+// Same as applyLimits() on all the channels at once
+void applyLimitsPlan(const int32_t * values, int16_t * outputs);
@@ -24,6 +24,8 @@
 
 #include "analogs.h"
 #include "switches.h"
+#include "mixer_outputs.h"
+#include "logs_encoder.h"
 #include "hal/adc_driver.h"
 #include "hal/switch_driver.h"
 
@@ -32,7 +34,7 @@
 #endif
 
 FIL g_oLogFile __DMA;
-uint8_t logDelay100ms;
+uint16_t logDelay10ms;
 static tmr10ms_t lastLogTime = 0;
 
 #if !defined(SIMU)
@@ -58,7 +60,7 @@ void loggingTimerStart()
 {
   if (!loggingTimer) {
     loggingTimer =
-        xTimerCreateStatic("Logging", logDelay100ms*100 / RTOS_MS_PER_TICK, pdTRUE, (void*)0,
+        xTimerCreateStatic("Logging", logDelay10ms*10 / RTOS_MS_PER_TICK, pdTRUE, (void*)0,
                            loggingTimerCb, &loggingTimerBuffer);
   }
 
@@ -80,18 +82,18 @@ void loggingTimerStop()
 }
 
 void initLoggingTimer() {                                       // called cyclically by main.cpp:perMain()
-  static uint8_t logDelay100msOld = 0;
+  static uint16_t logDelay10msOld = 0;
 
   if(loggingTimer == nullptr) {                                 // log Timer not running
-    if(isFunctionActive(FUNCTION_LOGS) && logDelay100ms > 0) {  // if SF Logging is active and log rate is valid
+    if(isFunctionActive(FUNCTION_LOGS) && logDelay10ms > 0) {   // if SF Logging is active and log rate is valid
       loggingTimerStart();                                      // start log timer
     }  
   } else {                                                      // log timer is already running
-    if(logDelay100msOld != logDelay100ms) {                     // if log rate was changed
-      logDelay100msOld = logDelay100ms;                         // memorize new log rate
+    if(logDelay10msOld != logDelay10ms) {                       // if log rate was changed
+      logDelay10msOld = logDelay10ms;                           // memorize new log rate
 
-      if(logDelay100ms > 0) {
-        if(xTimerChangePeriod( loggingTimer, logDelay100ms*100, 0 ) != pdPASS ) {  // and restart timer with new log rate
+      if(logDelay10ms > 0) {
+        if(xTimerChangePeriod( loggingTimer, logDelay10ms*10 / RTOS_MS_PER_TICK, 0 ) != pdPASS ) {  // and restart timer with new log rate
           /* The timer period could not be changed */
         }
       }
@@ -100,13 +102,26 @@ void initLoggingTimer() {                                       // called cyclic
 }
 #endif
 
-void writeHeader();
+static LogsEncoder logsEncoder __DMA;
 
-int getSwitchState(uint8_t swtch) {
-  int value = getValue(MIXSRC_FIRST_SWITCH + swtch);
+// columns of the open log
+static uint64_t logsSensors;
+static uint32_t logsPots;
+static uint32_t logsSwitches;
+
+static void writeHeader();
+
+static int getSwitchState(getvalue_t value) {
   return (value == 0) ? 0 : (value < 0) ? -1 : +1;
 }
 
+static bool logsWriteBlock(const uint8_t * block)
+{
+  UINT written;
+  return f_write(&g_oLogFile, block, LOGS_BLOCK_SIZE, &written) == FR_OK &&
+         written == LOGS_BLOCK_SIZE;
+}
+
 void logsInit()
 {
   memset(&g_oLogFile, 0, sizeof(g_oLogFile));
@@ -117,7 +132,7 @@ const char * logsOpen()
   // Determine and set log file filename
   FRESULT result;
 
-  // /LOGS/modelnamexxxxxx_YYYY-MM-DD-HHMMSS.log
+  // /LOGS/modelnamexxxxxx_YYYY-MM-DD-HHMMSS.etl
   char filename[sizeof(LOGS_PATH) + LEN_MODEL_NAME + 18 + 4 + 1];
 
   if (!sdMounted())
@@ -172,16 +187,29 @@ const char * logsOpen()
     return SDCARD_ERROR(result);
   }
 
-  if (f_size(&g_oLogFile) == 0) {
-    writeHeader();
+  // a log interrupted by a power loss may end in the middle of a block
+  static const uint8_t padding[32] = {};
+  while (f_size(&g_oLogFile) % LOGS_BLOCK_SIZE) {
+    UINT written;
+    UINT len = min<UINT>(sizeof(padding), LOGS_BLOCK_SIZE - f_size(&g_oLogFile) % LOGS_BLOCK_SIZE);
+    result = f_write(&g_oLogFile, padding, len, &written);
+    if (result != FR_OK || written != len) {
+      f_close(&g_oLogFile);
+      g_oLogFile.obj.fs = 0;
+      return SDCARD_ERROR(result);
+    }
   }
 
+  logsEncoder.init(logsWriteBlock);
+  writeHeader();
+
   return nullptr;
 }
 
 void logsClose()
 {
   if (g_oLogFile.obj.fs && sdMounted()) {
+    logsEncoder.flush();
     if (f_close(&g_oLogFile) != FR_OK) {
       // close failed, forget file
       g_oLogFile.obj.fs = 0;
@@ -191,76 +219,96 @@ void logsClose()
 
 }
 
-void writeHeader()
+static void writeHeader()
 {
+  uint16_t columns = 1;
+
+  logsSensors = 0;
+  for (int i=0; i<MAX_TELEMETRY_SENSORS; i++) {
+    if (isTelemetryFieldAvailable(i) && g_model.telemetrySensors[i].logs) {
+      logsSensors |= (uint64_t)1 << i;
+      columns++;
+    }
+  }
+
+  auto n_inputs = adcGetMaxInputs(ADC_INPUT_MAIN);
+  columns += n_inputs;
+
+  logsPots = 0;
+  for (uint8_t i = 0; i < adcGetMaxInputs(ADC_INPUT_POT); i++) {
+    if (IS_POT_AVAILABLE(i)) {
+      logsPots |= 1u << i;
+      columns++;
+    }
+  }
+
+  logsSwitches = 0;
+  for (uint8_t i = 0; i < switchGetMaxSwitches(); i++) {
+    if (SWITCH_EXISTS(i)) {
+      logsSwitches |= 1u << i;
+      columns++;
+    }
+  }
+
+  columns += 1 + MAX_OUTPUT_CHANNELS + 1;
+
+  logsEncoder.beginHeader(columns);
+
 #if defined(RTCLOCK)
-  f_puts("Date,Time,", &g_oLogFile);
+  logsEncoder.addColumn(LOGS_COLUMN_RTC, 0, "Date,Time");
 #else
-  f_puts("Time,", &g_oLogFile);
+  logsEncoder.addColumn(LOGS_COLUMN_TIME, 0, "Time");
 #endif
 
-
   char label[TELEM_LABEL_LEN+7];
   for (int i=0; i<MAX_TELEMETRY_SENSORS; i++) {
-    if (isTelemetryFieldAvailable(i)) {
+    if (logsSensors & ((uint64_t)1 << i)) {
       TelemetrySensor & sensor = g_model.telemetrySensors[i];
-      if (sensor.logs) {
-        memset(label, 0, sizeof(label));
-        strncpy(label, sensor.label, TELEM_LABEL_LEN);
-        uint8_t unit = sensor.unit;
-        if (unit == UNIT_CELLS ) unit = UNIT_VOLTS;
-        if (UNIT_RAW < unit && unit < UNIT_FIRST_VIRTUAL) {
-          strcat(label, "(");
-          strncat(label, STR_VTELEMUNIT[unit], 3);
-          strcat(label, ")");
-        }
-        strcat(label, ",");
-        f_puts(label, &g_oLogFile);
+      memset(label, 0, sizeof(label));
+      strncpy(label, sensor.label, TELEM_LABEL_LEN);
+      uint8_t unit = sensor.unit;
+      if (unit == UNIT_CELLS ) unit = UNIT_VOLTS;
+      if (UNIT_RAW < unit && unit < UNIT_FIRST_VIRTUAL) {
+        strcat(label, "(");
+        strncat(label, STR_VTELEMUNIT[unit], 3);
+        strcat(label, ")");
       }
+      if (sensor.unit == UNIT_GPS)
+        logsEncoder.addColumn(LOGS_COLUMN_GPS, 0, label);
+      else if (sensor.unit == UNIT_DATETIME)
+        logsEncoder.addColumn(LOGS_COLUMN_DATETIME, 0, label);
+      else if (sensor.unit == UNIT_TEXT)
+        logsEncoder.addColumn(LOGS_COLUMN_TEXT, 0, label);
+      else
+        logsEncoder.addColumn(LOGS_COLUMN_VALUE, sensor.prec, label);
     }
   }
 
-  auto n_inputs = adcGetMaxInputs(ADC_INPUT_MAIN);
   for (uint8_t i = 0; i < n_inputs; i++) {
-    const char* p = analogGetCanonicalName(ADC_INPUT_MAIN, i);
-    while (*p) { f_putc(*(p++), &g_oLogFile); }
-    f_putc(',', &g_oLogFile);
+    logsEncoder.addColumn(LOGS_COLUMN_VALUE, 0, analogGetCanonicalName(ADC_INPUT_MAIN, i));
   }
 
-  n_inputs = adcGetMaxInputs(ADC_INPUT_POT);
-  for (uint8_t i = 0; i < n_inputs; i++) {
-    if (!IS_POT_AVAILABLE(i)) continue;
-    const char* p = analogGetCanonicalName(ADC_INPUT_POT, i);
-    while (*p) { f_putc(*(p++), &g_oLogFile); }
-    f_putc(',', &g_oLogFile);
+  for (uint8_t i = 0; i < adcGetMaxInputs(ADC_INPUT_POT); i++) {
+    if (logsPots & (1u << i))
+      logsEncoder.addColumn(LOGS_COLUMN_VALUE, 0, analogGetCanonicalName(ADC_INPUT_POT, i));
   }
 
   for (uint8_t i = 0; i < switchGetMaxSwitches(); i++) {
-    if (SWITCH_EXISTS(i)) {
+    if (logsSwitches & (1u << i)) {
       char s[LEN_SWITCH_NAME + 2];
-      char * temp;
-      temp = getSwitchName(s, i);
-      *temp++ = ',';
-      *temp = '\0';
-      f_puts(s, &g_oLogFile);
+      *getSwitchName(s, i) = '\0';
+      logsEncoder.addColumn(LOGS_COLUMN_VALUE, 0, s);
     }
   }
-  f_puts("LSW,", &g_oLogFile);
-  
+  logsEncoder.addColumn(LOGS_COLUMN_BITS64, 0, "LSW");
+
   for (uint8_t channel = 0; channel < MAX_OUTPUT_CHANNELS; channel++) {
-    f_printf(&g_oLogFile, "CH%d(us),", channel+1);
+    char s[sizeof("CH32(us)")];
+    strcpy(strAppendUnsigned(strAppend(s, "CH"), channel + 1), "(us)");
+    logsEncoder.addColumn(LOGS_COLUMN_VALUE, 0, s);
   }
 
-  f_puts("TxBat(V)\n", &g_oLogFile);
-}
-
-uint32_t getLogicalSwitchesStates(uint8_t first)
-{
-  uint32_t result = 0;
-  for (uint8_t i=0; i<32; i++) {
-    result |= (getSwitch(SWSRC_FIRST_LOGICAL_SWITCH+first+i) << i);
-  }
-  return result;
+  logsEncoder.addColumn(LOGS_COLUMN_VALUE, 1, "TxBat(V)");
 }
 
 void logsWrite()
@@ -271,10 +319,10 @@ void logsWrite()
     return;
   }
 
-  if (isFunctionActive(FUNCTION_LOGS) && logDelay100ms > 0) {
+  if (isFunctionActive(FUNCTION_LOGS) && logDelay10ms > 0) {
     #if defined(SIMU) || !defined(RTCLOCK)
     tmr10ms_t tmr10ms = get_tmr10ms();                                        // tmr10ms works in 10ms increments
-    if (lastLogTime == 0 || (tmr10ms_t)(tmr10ms - lastLogTime) >= (tmr10ms_t)(logDelay100ms*10)-1) {
+    if (lastLogTime == 0 || (tmr10ms_t)(tmr10ms - lastLogTime) >= (tmr10ms_t)(logDelay10ms-1)) {
       lastLogTime = tmr10ms;
     #else
     {
@@ -305,57 +353,36 @@ void logsWrite()
       }
 
 
+      logsEncoder.beginRow();
+
 #if defined(RTCLOCK)
-      {
-        static struct gtm utm;
-        static gtime_t lastRtcTime = 0;
-        if (g_rtcTime != lastRtcTime) {
-          lastRtcTime = g_rtcTime;
-          gettime(&utm);
-        }
-        f_printf(&g_oLogFile, "%4d-%02d-%02d,%02d:%02d:%02d.%02d0,", utm.tm_year+TM_YEAR_BASE, utm.tm_mon+1, utm.tm_mday, utm.tm_hour, utm.tm_min, utm.tm_sec, g_ms100);
-      }
+      logsEncoder.addValue(g_rtcTime);
+      logsEncoder.addValue(g_ms100);
 #else
-      f_printf(&g_oLogFile, "%d,", tmr10ms);
+      logsEncoder.addValue(tmr10ms);
 #endif
 
       for (int i=0; i<MAX_TELEMETRY_SENSORS; i++) {
-        if (isTelemetryFieldAvailable(i)) {
+        if (logsSensors & ((uint64_t)1 << i)) {
           TelemetrySensor & sensor = g_model.telemetrySensors[i];
           TelemetryItem & telemetryItem = telemetryItems[i];
-          if (sensor.logs) {
-            if (sensor.unit == UNIT_GPS) {
-              if (telemetryItem.gps.longitude && telemetryItem.gps.latitude) {
-                div_t qr = div((int)telemetryItem.gps.latitude, 1000000);
-                if (telemetryItem.gps.latitude < 0) f_printf(&g_oLogFile, "-");
-                f_printf(&g_oLogFile, "%d.%06d ", abs(qr.quot), abs(qr.rem));
-                qr = div((int)telemetryItem.gps.longitude, 1000000);
-                if (telemetryItem.gps.longitude < 0) f_printf(&g_oLogFile, "-");
-                f_printf(&g_oLogFile, "%d.%06d,", abs(qr.quot), abs(qr.rem));
-              }
-              else {
-                f_printf(&g_oLogFile, ",");
-              }
-            }
-            else if (sensor.unit == UNIT_DATETIME) {
-              f_printf(&g_oLogFile, "%4d-%02d-%02d %02d:%02d:%02d,", telemetryItem.datetime.year, telemetryItem.datetime.month, telemetryItem.datetime.day, telemetryItem.datetime.hour, telemetryItem.datetime.min, telemetryItem.datetime.sec);
-            }
-            else if (sensor.unit == UNIT_TEXT) {
-              f_printf(&g_oLogFile, "\"%s\",", telemetryItem.text);
-            }
-            else if (sensor.prec == 2) {
-              div_t qr = div((int)telemetryItem.value, 100);
-              if (telemetryItem.value < 0) f_printf(&g_oLogFile, "-");
-              f_printf(&g_oLogFile, "%d.%02d,", abs(qr.quot), abs(qr.rem));
-            }
-            else if (sensor.prec == 1) {
-              div_t qr = div((int)telemetryItem.value, 10);
-              if (telemetryItem.value < 0) f_printf(&g_oLogFile, "-");
-              f_printf(&g_oLogFile, "%d.%d,", abs(qr.quot), abs(qr.rem));
-            }
-            else {
-              f_printf(&g_oLogFile, "%d,", telemetryItem.value);
-            }
+          if (sensor.unit == UNIT_GPS) {
+            logsEncoder.addValue(telemetryItem.gps.latitude);
+            logsEncoder.addValue(telemetryItem.gps.longitude);
+          }
+          else if (sensor.unit == UNIT_DATETIME) {
+            logsEncoder.addValue(telemetryItem.datetime.year * 10000 +
+                                 telemetryItem.datetime.month * 100 +
+                                 telemetryItem.datetime.day);
+            logsEncoder.addValue(telemetryItem.datetime.hour * 10000 +
+                                 telemetryItem.datetime.min * 100 +
+                                 telemetryItem.datetime.sec);
+          }
+          else if (sensor.unit == UNIT_TEXT) {
+            logsEncoder.addText(telemetryItem.text);
+          }
+          else {
+            logsEncoder.addValue(telemetryItem.value);
           }
         }
       }
@@ -364,33 +391,46 @@ void logsWrite()
       auto offset = adcGetInputOffset(ADC_INPUT_MAIN);
 
       for (uint8_t i = 0; i < n_inputs; i++) {
-        f_printf(&g_oLogFile, "%d,", calibratedAnalogs[inputMappingConvertMode(offset + i)]);
+        logsEncoder.addValue(calibratedAnalogs[inputMappingConvertMode(offset + i)]);
       }
 
       n_inputs = adcGetMaxInputs(ADC_INPUT_POT);
       offset = adcGetInputOffset(ADC_INPUT_POT);
 
       for (uint8_t i = 0; i < n_inputs; i++) {
-        if (IS_POT_AVAILABLE(i))
-          f_printf(&g_oLogFile, "%d,", calibratedAnalogs[offset + i]);
+        if (logsPots & (1u << i))
+          logsEncoder.addValue(calibratedAnalogs[offset + i]);
       }
 
+      // fetch all switch positions at once
+      mixsrc_t switchSources[MAX_SWITCHES];
+      getvalue_t switchValues[MAX_SWITCHES];
+      uint8_t switchCount = 0;
       for (uint8_t i = 0; i < switchGetMaxSwitches(); i++) {
-        if (SWITCH_EXISTS(i)) {
-          f_printf(&g_oLogFile, "%d,", getSwitchState(i));
+        if (logsSwitches & (1u << i)) {
+          switchSources[switchCount++] = MIXSRC_FIRST_SWITCH + i;
         }
       }
-      f_printf(&g_oLogFile, "0x%08X%08X,", getLogicalSwitchesStates(32),
-               getLogicalSwitchesStates(0));
+      getValues(switchSources, switchValues, switchCount);
+      for (uint8_t i = 0; i < switchCount; i++) {
+        logsEncoder.addValue(getSwitchState(switchValues[i]));
+      }
+      // logical switches and channels from the same mixer cycle
+      static MixerOutputs outputs;
+      mixerOutputsRead(outputs);
+
+      logsEncoder.addValue(outputs.logicalSwitches >> 32);
+      logsEncoder.addValue(outputs.logicalSwitches);
 
       for (uint8_t channel = 0; channel < MAX_OUTPUT_CHANNELS; channel++) {
-        f_printf(&g_oLogFile, "%d,", PPM_CENTER+channelOutputs[channel]/2); // in us
+        logsEncoder.addValue(PPM_CENTER+outputs.channels[channel]/2); // in us
       }
 
-      div_t qr = div(g_vbat100mV, 10);
-      int result = f_printf(&g_oLogFile, "%d.%d\n", abs(qr.quot), abs(qr.rem));
+      logsEncoder.addValue(g_vbat100mV);
+
+      bool result = !logsEncoder.hasError();
 
-      if (result<0 && !error_displayed) {
+      if (!result && !error_displayed) {
         error_displayed = STR_SDCARD_ERROR;
         POPUP_WARNING_ON_UI_TASK(STR_SDCARD_ERROR, nullptr, false);
         logsClose();
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#include "logs_encoder.h"
+
+void LogsEncoder::init(WriteBlock writeBlock)
+{
+  this->writeBlock = writeBlock;
+  position = 0;
+  valueIndex = 0;
+  error = false;
+  resetValues();
+}
+
+void LogsEncoder::resetValues()
+{
+  memclear(previous, sizeof(previous));
+}
+
+void LogsEncoder::put(uint8_t byte)
+{
+  block[position++] = byte;
+  if (position == LOGS_BLOCK_SIZE) {
+    if (!error && !writeBlock(block)) {
+      error = true;
+    }
+    position = 0;
+  }
+}
+
+void LogsEncoder::putVarint(uint32_t value)
+{
+  while (value >= 0x80) {
+    put(value | 0x80);
+    value >>= 7;
+  }
+  put(value);
+}
+
+void LogsEncoder::beginHeader(uint16_t columns)
+{
+  put(LOGS_RECORD_HEADER);
+  for (const char * c = LOGS_MAGIC; *c; c++) {
+    put(*c);
+  }
+  put(LOGS_VERSION);
+  putVarint(columns);
+  resetValues();
+}
+
+void LogsEncoder::addColumn(uint8_t type, uint8_t prec, const char * label)
+{
+  put(type);
+  put(prec);
+  do {
+    put(*label);
+  } while (*label++);
+}
+
+void LogsEncoder::beginRow()
+{
+  put(LOGS_RECORD_ROW);
+  valueIndex = 0;
+}
+
+void LogsEncoder::addValue(int32_t value)
+{
+  // the header never describes more values
+  if (valueIndex >= LOGS_MAX_VALUES)
+    return;
+
+  int32_t delta = int32_t(uint32_t(value) - uint32_t(previous[valueIndex]));
+  previous[valueIndex++] = value;
+  putVarint((uint32_t(delta) << 1) ^ uint32_t(delta >> 31));
+}
+
+void LogsEncoder::addText(const char * text)
+{
+  uint8_t len = strnlen(text, TELEMETRY_SENSOR_TEXT_LENGTH);
+  putVarint(len);
+  for (uint8_t i = 0; i < len; i++) {
+    put(text[i]);
+  }
+}
+
+void LogsEncoder::flush()
+{
+  if (position == 0)
+    return;
+
+  memclear(&block[position], LOGS_BLOCK_SIZE - position);
+  position = LOGS_BLOCK_SIZE - 1;
+  put(LOGS_RECORD_END);
+  resetValues();
+}
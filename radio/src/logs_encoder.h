@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#pragma once
+
+#include "opentx.h"
+
+// Binary logs
+//
+// A log is a stream of records, written to the file in blocks of
+// LOGS_BLOCK_SIZE bytes:
+//  - 'H' header: "ETXLOG", the format version, the number of columns
+//    (varint) and for each column its type, its precision and its CSV label
+//    ('\0' terminated)
+//  - 'R' row: the values of each column, in the header order. A text is
+//    written as its length (varint) followed by its characters, any other
+//    value as the zigzag varint of its difference with the same value in the
+//    previous row
+//  - 0: end of block, the rest of the block is padding
+//
+// The values of the first row after a header or after an end of block are
+// encoded from 0. The last block of a log is completed by an end of block,
+// so that a new log appended to the same file starts on a block boundary.
+// tools/logs-to-csv.py converts the logs to the CSV layout.
+
+#define LOGS_BLOCK_SIZE       512
+#define LOGS_MAGIC            "ETXLOG"
+#define LOGS_VERSION          1
+
+#define LOGS_RECORD_END       0x00
+#define LOGS_RECORD_HEADER    'H'
+#define LOGS_RECORD_ROW       'R'
+
+enum LogsColumnType {
+  LOGS_COLUMN_VALUE,     // value displayed with the column precision
+  LOGS_COLUMN_TIME,      // 10ms ticks
+  LOGS_COLUMN_RTC,       // seconds since 1970, 10ms (Date and Time columns)
+  LOGS_COLUMN_GPS,       // latitude, longitude (1e-6 degrees)
+  LOGS_COLUMN_DATETIME,  // YYYYMMDD, HHMMSS
+  LOGS_COLUMN_TEXT,      // text
+  LOGS_COLUMN_BITS64,    // high, low 32 bits (hexadecimal)
+};
+
+// values in a row: time, sensors, sticks and pots, switches, logical
+// switches, channels and battery
+#define LOGS_MAX_VALUES  (2 + 2 * MAX_TELEMETRY_SENSORS + MAX_ANALOG_INPUTS + MAX_SWITCHES + 2 + MAX_OUTPUT_CHANNELS + 1)
+
+class LogsEncoder
+{
+  public:
+    typedef bool (*WriteBlock)(const uint8_t * block);
+
+    // start a new log, blocks are written with writeBlock
+    void init(WriteBlock writeBlock);
+
+    void beginHeader(uint16_t columns);
+    void addColumn(uint8_t type, uint8_t prec, const char * label);
+
+    void beginRow();
+    void addValue(int32_t value);
+    void addText(const char * text);
+
+    // end the current block and write it
+    void flush();
+
+    // a block could not be written
+    bool hasError() const
+    {
+      return error;
+    }
+
+  protected:
+    uint8_t block[LOGS_BLOCK_SIZE];  // first, for DMA alignment
+    WriteBlock writeBlock;
+    uint16_t position;
+    uint16_t valueIndex;
+    bool error;
+    int32_t previous[LOGS_MAX_VALUES];
+
+    void put(uint8_t byte);
+    void putVarint(uint32_t value);
+    void resetValues();
+};
@@ -32,6 +32,8 @@
 #include "hal/rotary_encoder.h"
 #include "switches.h"
 #include "input_mapping.h"
+#include "tasks/mixer_task.h"
+#include "mixer_outputs.h"
 
 #if defined(LIBOPENUI)
   #include "libopenui.h"
@@ -2097,6 +2099,45 @@ static int luaGetAvailableMemory(lua_State * L)
   return 1;
 }
 
+/*luadoc
+@function getMixerLatencies([reset])
+
+Get the latency histograms summary of the mixer task stages
+
+@param reset (boolean) optional, reset the histograms after reading them
+
+@retval table with a `period` field (current mixer period in us) and one table
+per stage (`trigger`, `getADC`, `switches`, `evalMixes`, `pulses`, `cycle`, `task`) with
+ * `count` (number) samples count
+ * `p50`, `p99`, `p999`, `max` (number) durations in us
+
+@status current Introduced in 2.10.0
+*/
+static int luaGetMixerLatencies(lua_State * L)
+{
+  bool reset = lua_toboolean(L, 1);
+
+  lua_newtable(L);
+  lua_pushtableinteger(L, "period", mixerTaskGetLatencyPeriod());
+  for (uint8_t i = 0; i < MIXER_LATENCY_COUNT; i++) {
+    const LatencyHistogram & histogram = mixerTaskGetLatency(i);
+    lua_pushstring(L, mixerLatencyNames[i]);
+    lua_newtable(L);
+    lua_pushtableinteger(L, "count", histogram.getCount());
+    lua_pushtableinteger(L, "p50", histogram.getPercentile(500) / 2);
+    lua_pushtableinteger(L, "p99", histogram.getPercentile(990) / 2);
+    lua_pushtableinteger(L, "p999", histogram.getPercentile(999) / 2);
+    lua_pushtableinteger(L, "max", histogram.getMax() / 2);
+    lua_settable(L, -3);
+  }
+
+  if (reset) {
+    mixerTaskResetLatencies();
+  }
+
+  return 1;
+}
+
 /*luadoc
 @function resetGlobalTimer([type])
 
@@ -2466,7 +2507,7 @@ static int luaGetLogicalSwitchValue(lua_State * L)
   int id = luaL_checkinteger(L, 1);
 
   if (id >= 0 && id < MAX_LOGICAL_SWITCHES)
-    lua_pushboolean(L, getSwitch(SWSRC_FIRST_LOGICAL_SWITCH + id));
+    lua_pushboolean(L, (mixerOutputs().logicalSwitches >> id) & 1);
   else
     lua_pushnil(L);
   return 1;
@@ -2747,7 +2788,7 @@ static int luaGetOutputValue(lua_State * L)
 {
   mixsrc_t idx = luaL_checkinteger(L, 1);
   if (idx < MAX_OUTPUT_CHANNELS) {           // mixsrc_t is unsigned, no need to check for <0
-    lua_pushinteger(L, channelOutputs[idx]);
+    lua_pushinteger(L, mixerOutputs().channels[idx]);
   } else {
     lua_pushinteger(L, 0);
   }
@@ -2818,6 +2859,7 @@ LROT_BEGIN(etxlib, NULL, 0)
   LROT_FUNCENTRY( loadScript, luaLoadScript )
   LROT_FUNCENTRY( getUsage, luaGetUsage )
   LROT_FUNCENTRY( getAvailableMemory, luaGetAvailableMemory )
+  LROT_FUNCENTRY( getMixerLatencies, luaGetMixerLatencies )
   LROT_FUNCENTRY( resetGlobalTimer, luaResetGlobalTimer )
 #if LCD_DEPTH > 1 && !defined(COLORLCD)
   LROT_FUNCENTRY( GREY, luaGrey )
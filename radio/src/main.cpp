@@ -21,6 +21,8 @@
 
 #include "opentx.h"
 #include "hal/adc_driver.h"
+#include "input_record.h"
+#include "mixer_outputs.h"
 
 #if defined(LIBOPENUI)
   #include "libopenui.h"
@@ -505,6 +507,10 @@ void perMain()
     #else
       logsWrite();         // call logsWrite the old way for simu
     #endif
+
+#if defined(INPUT_RECORD)
+    inputRecordFlush();
+#endif
   }
 
   handleUsbConnection();
@@ -578,6 +584,9 @@ void perMain()
 #endif
 
 #if defined(GUI)
+  // one consistent view of the mixer outputs for the whole UI cycle
+  mixerOutputsRefresh();
+
   DEBUG_TIMER_START(debugTimerGuiMain);
 #if defined(LIBOPENUI)
   guiMain(0);
@@ -23,6 +23,10 @@
 #include "timers.h"
 #include "switches.h"
 #include "input_mapping.h"
+#include "mixer_plan.h"
+#include "limits_plan.h"
+#include "input_plan.h"
+#include "mixer_outputs.h"
 
 #include "hal/adc_driver.h"
 #include "hal/trainer_driver.h"
@@ -36,13 +40,14 @@ int16_t trims[MAX_TRIMS] = {0};
 int32_t chans[MAX_OUTPUT_CHANNELS] = {0};
 BeepANACenter bpanaCenter = 0;
 
-int32_t act   [MAX_MIXERS] = {0};
 SwOn    swOn  [MAX_MIXERS]; // TODO better name later...
 
 uint8_t mixWarning;
 
 int16_t calibratedAnalogs[MAX_ANALOG_INPUTS];
 int16_t channelOutputs[MAX_OUTPUT_CHANNELS] = {0};
+uint16_t channelOutputsSampleTime = 0;
+uint16_t channelOutputsTime = 0;
 int16_t ex_chans[MAX_OUTPUT_CHANNELS] = {0}; // Outputs (before LIMITS) of the last perMain;
 
 #if defined(HELI)
@@ -236,7 +241,7 @@ int16_t applyLimits(uint8_t channel, int32_t value)
   }
 #endif
 
-  if (isFunctionActive(FUNCTION_TRAINER_CHANNELS) && is_trainer_connected()) {
+  if (channel < MAX_TRAINER_CHANNELS && isFunctionActive(FUNCTION_TRAINER_CHANNELS) && is_trainer_connected()) {
     return trainerInput[channel] * 2;
   }
 
@@ -295,173 +300,332 @@ int16_t applyLimits(uint8_t channel, int32_t value)
   return ofs;
 }
 
-// TODO same naming convention than the drawSource
-// *valid added to return status to Lua for invalid sources
-getvalue_t getValue(mixsrc_t i, bool* valid)
+// Source dispatch table
+//
+// Each source index is mapped to the range it belongs to, and each range has
+// its own accessor. The table is built once, when the number of inputs and
+// switches of the board is known, so that getValue() does not have to walk
+// through a long chain of range comparisons on every call.
+
+enum SourceRange {
+  SOURCE_RANGE_INVALID,
+  SOURCE_RANGE_INPUT,
+#if defined(LUA_INPUTS)
+  SOURCE_RANGE_LUA,
+#endif
+  SOURCE_RANGE_STICK,
+  SOURCE_RANGE_POT,
+#if MAX_AXIS > 0
+  SOURCE_RANGE_AXIS,
+#endif
+#if defined(IMU)
+  SOURCE_RANGE_TILT,
+#endif
+#if defined(SPACEMOUSE)
+  SOURCE_RANGE_SPACEMOUSE,
+#endif
+  SOURCE_RANGE_MIN,
+  SOURCE_RANGE_MAX,
+  SOURCE_RANGE_HELI,
+  SOURCE_RANGE_TRIM,
+  SOURCE_RANGE_SWITCH,
+#if defined(FUNCTION_SWITCHES)
+  SOURCE_RANGE_FS_SWITCH,
+#endif
+  SOURCE_RANGE_LOGICAL_SWITCH,
+  SOURCE_RANGE_TRAINER,
+  SOURCE_RANGE_CH,
+  SOURCE_RANGE_GVAR,
+  SOURCE_RANGE_TX_VOLTAGE,
+  SOURCE_RANGE_TX_TIME,
+  SOURCE_RANGE_TIMER,
+  SOURCE_RANGE_TELEM,
+  SOURCE_RANGE_COUNT
+};
+
+typedef getvalue_t (*SourceGetter)(mixsrc_t i, bool* valid);
+
+static inline getvalue_t invalidSource(bool* valid)
 {
-  if (i == MIXSRC_NONE) {
-    if (valid != nullptr) *valid = false;
-    return 0;
-  }
-  else if (i <= MIXSRC_LAST_INPUT) {
-    return anas[i - MIXSRC_FIRST_INPUT];
-  }
+  if (valid != nullptr) *valid = false;
+  return 0;
+}
+
+static getvalue_t getInvalidSource(mixsrc_t, bool* valid)
+{
+  return invalidSource(valid);
+}
+
+static getvalue_t getInputSource(mixsrc_t i, bool*)
+{
+  inputPlanRequest(i - MIXSRC_FIRST_INPUT);
+  return anas[i - MIXSRC_FIRST_INPUT];
+}
+
 #if defined(LUA_INPUTS)
-  else if (i <= MIXSRC_LAST_LUA) {
+static getvalue_t getLuaSource(mixsrc_t i, bool* valid)
+{
 #if defined(LUA_MODEL_SCRIPTS)
-    div_t qr = div(i-MIXSRC_FIRST_LUA, MAX_SCRIPT_OUTPUTS);
-    return scriptInputsOutputs[qr.quot].outputs[qr.rem].value;
+  div_t qr = div(i-MIXSRC_FIRST_LUA, MAX_SCRIPT_OUTPUTS);
+  return scriptInputsOutputs[qr.quot].outputs[qr.rem].value;
 #else
-    if (valid != nullptr) *valid = false;
-    return 0;
+  return invalidSource(valid);
 #endif
-  }
+}
 #endif
 
-  else if (i <= MIXSRC_LAST_STICK) {
-    i -= MIXSRC_FIRST_STICK;
-    if (i >= adcGetMaxInputs(ADC_INPUT_MAIN)) {
-      if (valid != nullptr) *valid = false;
-      return 0;
-    }
-    return calibratedAnalogs[inputMappingConvertMode(i)];
-  }
-  else if (i <= MIXSRC_LAST_POT) {
-    i -= MIXSRC_FIRST_POT;
-    if (i >= adcGetMaxInputs(ADC_INPUT_POT)) {
-      if (valid != nullptr) *valid = false;
-      return 0;
-    }
-    return calibratedAnalogs[i + adcGetInputOffset(ADC_INPUT_POT)];
-  }
+static getvalue_t getStickSource(mixsrc_t i, bool*)
+{
+  return calibratedAnalogs[inputMappingConvertMode(i - MIXSRC_FIRST_STICK)];
+}
+
+static getvalue_t getPotSource(mixsrc_t i, bool*)
+{
+  return calibratedAnalogs[i - MIXSRC_FIRST_POT + adcGetInputOffset(ADC_INPUT_POT)];
+}
 
 #if MAX_AXIS > 0
-  else if (i <= MIXSRC_LAST_AXIS) {
-    i -= MIXSRC_FIRST_AXIS;
-    if (i >= adcGetMaxInputs(ADC_INPUT_AXIS)) {
-      if (valid != nullptr) *valid = false;
-      return 0;
-    }
-    return calibratedAnalogs[i + adcGetInputOffset(ADC_INPUT_AXIS)];
-  }
+static getvalue_t getAxisSource(mixsrc_t i, bool*)
+{
+  return calibratedAnalogs[i - MIXSRC_FIRST_AXIS + adcGetInputOffset(ADC_INPUT_AXIS)];
+}
 #endif
 
 #if defined(IMU)
-  else if (i == MIXSRC_TILT_X) {
-    return gyro.scaledX();
-  }
-  else if (i == MIXSRC_TILT_Y) {
-    return gyro.scaledY();
-  }
+static getvalue_t getTiltSource(mixsrc_t i, bool*)
+{
+  return i == MIXSRC_TILT_X ? gyro.scaledX() : gyro.scaledY();
+}
 #endif
 
 #if defined(SPACEMOUSE)
-  else if (i >= MIXSRC_FIRST_SPACEMOUSE && i <= MIXSRC_LAST_SPACEMOUSE) {
-    return get_spacemouse_value(i - MIXSRC_FIRST_SPACEMOUSE);
-  }
+static getvalue_t getSpacemouseSource(mixsrc_t i, bool*)
+{
+  return get_spacemouse_value(i - MIXSRC_FIRST_SPACEMOUSE);
+}
 #endif
 
-  else if (i == MIXSRC_MIN) {
-    return -RESX;
-  }
-  else if (i == MIXSRC_MAX) {
-    return RESX;
-  }
+static getvalue_t getMinSource(mixsrc_t, bool*)
+{
+  return -RESX;
+}
+
+static getvalue_t getMaxSource(mixsrc_t, bool*)
+{
+  return RESX;
+}
 
-  else if (i <= MIXSRC_LAST_HELI) {
+static getvalue_t getHeliSource(mixsrc_t i, bool* valid)
+{
 #if defined(HELI)
-    return cyc_anas[i - MIXSRC_FIRST_HELI];
+  return cyc_anas[i - MIXSRC_FIRST_HELI];
 #else
-    if (valid != nullptr) *valid = false;
-    return 0;
+  return invalidSource(valid);
 #endif
-  }
+}
 
-  else if (i <= MIXSRC_LAST_TRIM) {
-    i -= MIXSRC_FIRST_TRIM;
-    auto trim_value = getTrimValue(mixerCurrentFlightMode, i);
-    return calc1000toRESX((int16_t)8 * trim_value);
-  }
-#if defined(FUNCTION_SWITCHES)
-  else if (i >= MIXSRC_FIRST_SWITCH && i <= MIXSRC_LAST_REGULAR_SWITCH) {
-    mixsrc_t sw = i - MIXSRC_FIRST_SWITCH;
-    if (SWITCH_EXISTS(sw)) {
-      return (switchState(3*sw) ? -1024 : (IS_CONFIG_3POS(sw) && switchState(3*sw+1) ? 0 : 1024));
-    }
-    else {
-      if (valid != nullptr) *valid = false;
-      return 0;
-    }
-  } else if (i >= MIXSRC_FIRST_FS_SWITCH && i <= MIXSRC_LAST_SWITCH) {
-    return getFSLogicalState(i - MIXSRC_FIRST_SWITCH - switchGetMaxSwitches()) ? +1024 : -1024;
+static getvalue_t getTrimSource(mixsrc_t i, bool*)
+{
+  auto trim_value = getTrimValue(mixerCurrentFlightMode, i - MIXSRC_FIRST_TRIM);
+  return calc1000toRESX((int16_t)8 * trim_value);
+}
+
+static getvalue_t getSwitchSource(mixsrc_t i, bool* valid)
+{
+  mixsrc_t sw = i - MIXSRC_FIRST_SWITCH;
+  if (SWITCH_EXISTS(sw)) {
+    return (switchState(3*sw) ? -1024 : (IS_CONFIG_3POS(sw) && switchState(3*sw+1) ? 0 : 1024));
   }
-#else
-  else if (i >= MIXSRC_FIRST_SWITCH && i <= MIXSRC_LAST_SWITCH) {
-    mixsrc_t sw = i - MIXSRC_FIRST_SWITCH;
-    if (SWITCH_EXISTS(sw)) {
-      return (switchState(3*sw) ? -1024 : (IS_CONFIG_3POS(sw) && switchState(3*sw+1) ? 0 : 1024));
-    }
-    else {
-      if (valid != nullptr) *valid = false;
-      return 0;
-    }
+  else {
+    return invalidSource(valid);
   }
+}
+
+#if defined(FUNCTION_SWITCHES)
+static getvalue_t getFSSwitchSource(mixsrc_t i, bool*)
+{
+  return getFSLogicalState(i - MIXSRC_FIRST_SWITCH - switchGetMaxSwitches()) ? +1024 : -1024;
+}
 #endif
 
-  else if (i <= MIXSRC_LAST_LOGICAL_SWITCH) {
-    return getSwitch(SWSRC_FIRST_LOGICAL_SWITCH + i - MIXSRC_FIRST_LOGICAL_SWITCH) ? 1024 : -1024;
-  } else if (i <= MIXSRC_LAST_TRAINER) {
-    int16_t x = trainerInput[i - MIXSRC_FIRST_TRAINER];
-    if (i < MIXSRC_FIRST_TRAINER + NUM_CAL_PPM) {
-      x -= g_eeGeneral.trainer.calib[i - MIXSRC_FIRST_TRAINER];
-    }
-    return x * 2;
-  } else if (i <= MIXSRC_LAST_CH) {
-    return ex_chans[i - MIXSRC_FIRST_CH];
+static getvalue_t getLogicalSwitchSource(mixsrc_t i, bool*)
+{
+  return getSwitch(SWSRC_FIRST_LOGICAL_SWITCH + i - MIXSRC_FIRST_LOGICAL_SWITCH) ? 1024 : -1024;
+}
+
+static getvalue_t getTrainerSource(mixsrc_t i, bool*)
+{
+  int16_t x = trainerInput[i - MIXSRC_FIRST_TRAINER];
+  if (i < MIXSRC_FIRST_TRAINER + NUM_CAL_PPM) {
+    x -= g_eeGeneral.trainer.calib[i - MIXSRC_FIRST_TRAINER];
   }
+  return x * 2;
+}
 
-  else if (i <= MIXSRC_LAST_GVAR) {
+static getvalue_t getChannelSource(mixsrc_t i, bool*)
+{
+  return ex_chans[i - MIXSRC_FIRST_CH];
+}
+
+static getvalue_t getGVarSource(mixsrc_t i, bool* valid)
+{
 #if defined(GVARS)
-    return GVAR_VALUE(i - MIXSRC_FIRST_GVAR, getGVarFlightMode(mixerCurrentFlightMode, i - MIXSRC_FIRST_GVAR));
+  return getGVarValue(i - MIXSRC_FIRST_GVAR, mixerCurrentFlightMode);
 #else
-    if (valid != nullptr) *valid = false;
-    return 0;
+  return invalidSource(valid);
 #endif
-  }
+}
 
-  else if (i == MIXSRC_TX_VOLTAGE) {
-    return g_vbat100mV;
-  } else if (i < MIXSRC_FIRST_TIMER) {
-    // TX_TIME + SPARES
+static getvalue_t getTxVoltageSource(mixsrc_t, bool*)
+{
+  return g_vbat100mV;
+}
+
+static getvalue_t getTxTimeSource(mixsrc_t, bool* valid)
+{
+  // TX_TIME + SPARES
 #if defined(RTCLOCK)
-    return (g_rtcTime % SECS_PER_DAY) / 60; // number of minutes from midnight
+  return (g_rtcTime % SECS_PER_DAY) / 60; // number of minutes from midnight
 #else
-    if (valid != nullptr) *valid = false;
-    return 0;
+  return invalidSource(valid);
 #endif
-  } else if (i <= MIXSRC_LAST_TIMER) {
-    return timersStates[i - MIXSRC_FIRST_TIMER].val;
+}
+
+static getvalue_t getTimerSource(mixsrc_t i, bool*)
+{
+  return timersStates[i - MIXSRC_FIRST_TIMER].val;
+}
+
+static getvalue_t getTelemetrySource(mixsrc_t i, bool* valid)
+{
+  if (IS_FAI_FORBIDDEN(i)) {
+    return invalidSource(valid);
+  }
+  i -= MIXSRC_FIRST_TELEM;
+  div_t qr = div(i, 3);
+  TelemetryItem & telemetryItem = telemetryItems[qr.quot];
+  switch (qr.rem) {
+    case 1:
+      return telemetryItem.valueMin;
+    case 2:
+      return telemetryItem.valueMax;
+    default:
+      return telemetryItem.value;
   }
+}
 
-  else if (i <= MIXSRC_LAST_TELEM) {
-    if (IS_FAI_FORBIDDEN(i)) {
-      if (valid != nullptr) *valid = false;
-      return 0;
-    }
-    i -= MIXSRC_FIRST_TELEM;
-    div_t qr = div(i, 3);
-    TelemetryItem & telemetryItem = telemetryItems[qr.quot];
-    switch (qr.rem) {
-      case 1:
-        return telemetryItem.valueMin;
-      case 2:
-        return telemetryItem.valueMax;
-      default:
-        return telemetryItem.value;
-    }
-  } else {
-    if (valid != nullptr) *valid = false;
-    return 0;
+static const SourceGetter sourceGetters[SOURCE_RANGE_COUNT] = {
+  getInvalidSource,
+  getInputSource,
+#if defined(LUA_INPUTS)
+  getLuaSource,
+#endif
+  getStickSource,
+  getPotSource,
+#if MAX_AXIS > 0
+  getAxisSource,
+#endif
+#if defined(IMU)
+  getTiltSource,
+#endif
+#if defined(SPACEMOUSE)
+  getSpacemouseSource,
+#endif
+  getMinSource,
+  getMaxSource,
+  getHeliSource,
+  getTrimSource,
+  getSwitchSource,
+#if defined(FUNCTION_SWITCHES)
+  getFSSwitchSource,
+#endif
+  getLogicalSwitchSource,
+  getTrainerSource,
+  getChannelSource,
+  getGVarSource,
+  getTxVoltageSource,
+  getTxTimeSource,
+  getTimerSource,
+  getTelemetrySource,
+};
+
+static uint8_t sourceRanges[MIXSRC_LAST_TELEM + 1];
+
+static void setSourceRange(mixsrc_t first, mixsrc_t last, uint8_t range)
+{
+  for (mixsrc_t i = first; i <= last; i++) {
+    sourceRanges[i] = range;
+  }
+}
+
+// sources in [first, first+count) belong to range, the remaining ones up to
+// last do not exist on this board
+static void setSourceRange(mixsrc_t first, mixsrc_t last, uint8_t range, uint8_t count)
+{
+  if (count > 0) {
+    setSourceRange(first, min<mixsrc_t>(last, first + count - 1), range);
+  }
+}
+
+// only depends on the board, built once at boot before the tasks start
+void sourceRangesInit()
+{
+  memclear(sourceRanges, sizeof(sourceRanges));
+
+  setSourceRange(MIXSRC_FIRST_INPUT, MIXSRC_LAST_INPUT, SOURCE_RANGE_INPUT);
+#if defined(LUA_INPUTS)
+  setSourceRange(MIXSRC_FIRST_LUA, MIXSRC_LAST_LUA, SOURCE_RANGE_LUA);
+#endif
+  setSourceRange(MIXSRC_FIRST_STICK, MIXSRC_LAST_STICK, SOURCE_RANGE_STICK,
+                 adcGetMaxInputs(ADC_INPUT_MAIN));
+  setSourceRange(MIXSRC_FIRST_POT, MIXSRC_LAST_POT, SOURCE_RANGE_POT,
+                 adcGetMaxInputs(ADC_INPUT_POT));
+#if MAX_AXIS > 0
+  setSourceRange(MIXSRC_FIRST_AXIS, MIXSRC_LAST_AXIS, SOURCE_RANGE_AXIS,
+                 adcGetMaxInputs(ADC_INPUT_AXIS));
+#endif
+#if defined(IMU)
+  setSourceRange(MIXSRC_TILT_X, MIXSRC_TILT_Y, SOURCE_RANGE_TILT);
+#endif
+#if defined(SPACEMOUSE)
+  setSourceRange(MIXSRC_FIRST_SPACEMOUSE, MIXSRC_LAST_SPACEMOUSE, SOURCE_RANGE_SPACEMOUSE);
+#endif
+  sourceRanges[MIXSRC_MIN] = SOURCE_RANGE_MIN;
+  sourceRanges[MIXSRC_MAX] = SOURCE_RANGE_MAX;
+  setSourceRange(MIXSRC_FIRST_HELI, MIXSRC_LAST_HELI, SOURCE_RANGE_HELI);
+  setSourceRange(MIXSRC_FIRST_TRIM, MIXSRC_LAST_TRIM, SOURCE_RANGE_TRIM);
+#if defined(FUNCTION_SWITCHES)
+  setSourceRange(MIXSRC_FIRST_SWITCH, MIXSRC_LAST_REGULAR_SWITCH, SOURCE_RANGE_SWITCH);
+  setSourceRange(MIXSRC_FIRST_FS_SWITCH, MIXSRC_LAST_SWITCH, SOURCE_RANGE_FS_SWITCH);
+#else
+  setSourceRange(MIXSRC_FIRST_SWITCH, MIXSRC_LAST_SWITCH, SOURCE_RANGE_SWITCH);
+#endif
+  setSourceRange(MIXSRC_FIRST_LOGICAL_SWITCH, MIXSRC_LAST_LOGICAL_SWITCH, SOURCE_RANGE_LOGICAL_SWITCH);
+  setSourceRange(MIXSRC_FIRST_TRAINER, MIXSRC_LAST_TRAINER, SOURCE_RANGE_TRAINER);
+  setSourceRange(MIXSRC_FIRST_CH, MIXSRC_LAST_CH, SOURCE_RANGE_CH);
+  setSourceRange(MIXSRC_FIRST_GVAR, MIXSRC_LAST_GVAR, SOURCE_RANGE_GVAR);
+  sourceRanges[MIXSRC_TX_VOLTAGE] = SOURCE_RANGE_TX_VOLTAGE;
+  setSourceRange(MIXSRC_TX_TIME, MIXSRC_FIRST_TIMER - 1, SOURCE_RANGE_TX_TIME);
+  setSourceRange(MIXSRC_FIRST_TIMER, MIXSRC_LAST_TIMER, SOURCE_RANGE_TIMER);
+  setSourceRange(MIXSRC_FIRST_TELEM, MIXSRC_LAST_TELEM, SOURCE_RANGE_TELEM);
+}
+
+// TODO same naming convention than the drawSource
+// *valid added to return status to Lua for invalid sources
+getvalue_t getValue(mixsrc_t i, bool* valid)
+{
+  if (i > MIXSRC_LAST_TELEM) {
+    return invalidSource(valid);
+  }
+
+  return sourceGetters[sourceRanges[i]](i, valid);
+}
+
+void getValues(const mixsrc_t* sources, getvalue_t* values, uint8_t count)
+{
+  for (uint8_t n = 0; n < count; n++) {
+    mixsrc_t i = sources[n];
+    values[n] = (i > MIXSRC_LAST_TELEM ? 0 : sourceGetters[sourceRanges[i]](i, nullptr));
   }
 }
 
@@ -598,7 +762,7 @@ void evalInputs(uint8_t mode)
   }
 
   // EXPOs
-  applyExpos(anas, mode);
+  applyInputPlan(anas, mode);
 
   // TRIMs
   // when no virtual inputs, the trims need the anas array calculated above
@@ -651,7 +815,7 @@ int getSourceTrimValue(int source, int stickValue=0)
 
 uint8_t mixerCurrentFlightMode;
 
-void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
+static void evalFlightModeInputs(uint8_t mode, uint8_t tick10ms)
 {
   evalInputs(mode);
 
@@ -725,99 +889,103 @@ void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
     cyc_anas[0] = cyc_anas[1] = cyc_anas[2] = 0;
   }
 #endif
+}
 
-  memclear(chans, sizeof(chans)); // all outputs to 0
+// Evaluate the mix lines of the given channels, the other channels are left
+// untouched in chans[]
+static void evalFlightModeChannels(uint8_t mode, uint8_t tick10ms, bitfield_channels_t channels)
+{
+  mixPlanUpdate();
 
   //========== MIXER LOOP ===============
   uint8_t lv_mixWarning = 0;
 
-  uint8_t pass = 0;
-
-  bitfield_channels_t dirtyChannels = (bitfield_channels_t)-1; // all dirty when mixer starts
-
-  do {
-    bitfield_channels_t passDirtyChannels = 0;
+  // the plan is in the channels dependency order: a channel used as source
+  // is already computed, unless it is in a loop with the destination channel
+  for (uint8_t p = 0; p < mixPlan.count; p++) {
+    const MixPlanItem & item = mixPlan.items[p];
+    uint8_t i = item.index;
+    MixData * md = item.md;
 
-    for (uint8_t i=0; i<MAX_MIXERS; i++) {
-      if (mode == e_perout_mode_normal && pass == 0)
-        swOn[i].activeMix = 0;
+    if (mode == e_perout_mode_normal)
+      swOn[i].activeMix = 0;
 
-      MixData * md = mixAddress(i);
-
-      if (md->srcRaw == 0)
-#if defined(COLORLCD)
-        continue;
-#else
-        break;
-#endif
-
-      mixsrc_t stickIndex = md->srcRaw - MIXSRC_FIRST_STICK;
-
-      if (!(dirtyChannels & ((bitfield_channels_t)1 << md->destCh)))
-        continue;
+    if (!(channels & ((bitfield_channels_t)1 << item.destCh)))
+      continue;
 
-      // if this is the first calculation for the destination channel, initialize it with 0 (otherwise would be random)
-      if (i == 0 || md->destCh != (md-1)->destCh)
-        chans[md->destCh] = 0;
+    // if this is the first calculation for the destination channel, initialize it with 0 (otherwise would be random)
+    if (item.flags & MIX_PLAN_FIRST_LINE)
+      chans[item.destCh] = 0;
 
-      //========== FLIGHT MODE && SWITCH =====
-      bool mixCondition = (md->flightModes != 0 || md->swtch);
-      delayval_t mixEnabled = (!(md->flightModes & (1 << mixerCurrentFlightMode)) && getSwitch(md->swtch)) ? DELAY_POS_MARGIN+1 : 0;
+    //========== FLIGHT MODE && SWITCH =====
+    bool mixCondition = (item.flags & MIX_PLAN_CONDITION);
+    delayval_t mixEnabled = (!mixCondition || (!(md->flightModes & (1 << mixerCurrentFlightMode)) && getSwitch(md->swtch))) ? DELAY_POS_MARGIN+1 : 0;
 
 #define MIXER_LINE_DISABLE()   (mixCondition = true, mixEnabled = 0)
 
-      if (mixEnabled && md->srcRaw >= MIXSRC_FIRST_TRAINER && md->srcRaw <= MIXSRC_LAST_TRAINER && !is_trainer_connected()) {
-        MIXER_LINE_DISABLE();
-      }
+    if (mixEnabled && (item.flags & MIX_PLAN_SRC_TRAINER) && !is_trainer_connected()) {
+      MIXER_LINE_DISABLE();
+    }
 
 #if defined(LUA_MODEL_SCRIPTS)
-      // disable mixer if Lua script is used as source and script was killed
-      if (mixEnabled && md->srcRaw >= MIXSRC_FIRST_LUA && md->srcRaw <= MIXSRC_LAST_LUA) {
-        div_t qr = div(md->srcRaw-MIXSRC_FIRST_LUA, MAX_SCRIPT_OUTPUTS);
-        if (scriptInternalData[qr.quot].state != SCRIPT_OK) {
-          MIXER_LINE_DISABLE();
-        }
+    // disable mixer if Lua script is used as source and script was killed
+    if (mixEnabled && (item.flags & MIX_PLAN_SRC_LUA)) {
+      div_t qr = div(item.srcRaw-MIXSRC_FIRST_LUA, MAX_SCRIPT_OUTPUTS);
+      if (scriptInternalData[qr.quot].state != SCRIPT_OK) {
+        MIXER_LINE_DISABLE();
       }
+    }
 #endif
 
-      //========== VALUE ===============
-      getvalue_t v = 0;
-      if (mode > e_perout_mode_inactive_flight_mode) {
-        if (mixEnabled)
-          v = getValue(md->srcRaw);
-        else
-          continue;
+    //========== VALUE ===============
+    getvalue_t v = 0;
+    if (mode > e_perout_mode_inactive_flight_mode) {
+      if (mixEnabled)
+        v = getValue(item.srcRaw);
+      else
+        continue;
+    }
+    else {
+      if (item.flags & MIX_PLAN_SRC_CH_READY)
+        v = chans[item.srcRaw - MIXSRC_FIRST_CH] >> 8;
+      else
+        v = getValue(item.srcRaw);
+      if (!mixCondition) {
+        mixEnabled = v;
       }
-      else {
-        mixsrc_t srcRaw = MIXSRC_FIRST_STICK + stickIndex;
-        v = getValue(srcRaw);
-        srcRaw -= MIXSRC_FIRST_CH;
-        if (srcRaw <= MIXSRC_LAST_CH-MIXSRC_FIRST_CH && md->destCh != srcRaw) {
-          if (dirtyChannels & ((bitfield_channels_t)1 << srcRaw) & (passDirtyChannels|~(((bitfield_channels_t) 1 << md->destCh)-1)))
-            passDirtyChannels |= (bitfield_channels_t) 1 << md->destCh;
-          if (srcRaw < md->destCh || pass > 0)
-            v = chans[srcRaw] >> 8;
+    }
+
+    bool applyOffsetAndCurve = true;
+
+    //========== DELAYS ===============
+    if (!(item.flags & MIX_PLAN_DELAY)) {
+      // no delay configured: the line state simply follows its condition
+      if (!mixEnabled) {
+        if ((item.flags & MIX_PLAN_SLOW) && item.mltpx != MLTPX_REPL) {
+          if (mixCondition) {
+            v = (item.mltpx == MLTPX_ADD ? 0 : RESX);
+            applyOffsetAndCurve = false;
+          }
         }
-        if (!mixCondition) {
-          mixEnabled = v;
+        else if (mixCondition) {
+          continue;
         }
       }
-
-      bool applyOffsetAndCurve = true;
-
-      //========== DELAYS ===============
-      delayval_t _swOn = swOn[i].now;
-      delayval_t _swPrev = swOn[i].prev;
+    }
+    else {
+      uint8_t s = item.state;
+      delayval_t _swOn = mixRuntime.now[s];
+      delayval_t _swPrev = mixRuntime.prev[s];
       bool swTog = (mixEnabled > _swOn+DELAY_POS_MARGIN || mixEnabled < _swOn-DELAY_POS_MARGIN);
       if (mode == e_perout_mode_normal && swTog) {
-        if (!swOn[i].delay)
+        if (!mixRuntime.delay[s])
           _swPrev = _swOn;
-        swOn[i].delay = (mixEnabled > _swOn ? md->delayUp : md->delayDown) * 10;
-        swOn[i].now = mixEnabled;
-        swOn[i].prev = _swPrev;
+        mixRuntime.delay[s] = (mixEnabled > _swOn ? md->delayUp : md->delayDown) * 10;
+        mixRuntime.now[s] = mixEnabled;
+        mixRuntime.prev[s] = _swPrev;
       }
-      if (mode == e_perout_mode_normal && swOn[i].delay > 0) {
-        swOn[i].delay = max<int16_t>(0, (int16_t)swOn[i].delay - tick10ms);
+      if (mode == e_perout_mode_normal && mixRuntime.delay[s] > 0) {
+        mixRuntime.delay[s] = max<int16_t>(0, (int16_t)mixRuntime.delay[s] - tick10ms);
         if (!mixCondition)
           v = _swPrev;
         else if (mixEnabled)
@@ -825,12 +993,12 @@ void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
       }
       else {
         if (mode==e_perout_mode_normal) {
-          swOn[i].now = swOn[i].prev = mixEnabled;
+          mixRuntime.now[s] = mixRuntime.prev[s] = mixEnabled;
         }
         if (!mixEnabled) {
-          if ((md->speedDown || md->speedUp) && md->mltpx!=MLTPX_REPL) {
+          if ((item.flags & MIX_PLAN_SLOW) && item.mltpx != MLTPX_REPL) {
             if (mixCondition) {
-              v = (md->mltpx == MLTPX_ADD ? 0 : RESX);
+              v = (item.mltpx == MLTPX_ADD ? 0 : RESX);
               applyOffsetAndCurve = false;
             }
           }
@@ -839,159 +1007,234 @@ void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
           }
         }
       }
+    }
 
-      if (mode==e_perout_mode_normal && (!mixCondition || mixEnabled || swOn[i].delay)) {
-        if (md->mixWarn)
-          lv_mixWarning |= 1 << (md->mixWarn - 1);
-        swOn[i].activeMix = true;
-      }
+    if (mode==e_perout_mode_normal && (!mixCondition || mixEnabled || ((item.flags & MIX_PLAN_DELAY) && mixRuntime.delay[item.state]))) {
+      if (item.flags & MIX_PLAN_MIX_WARN)
+        lv_mixWarning |= 1 << (md->mixWarn - 1);
+      swOn[i].activeMix = true;
+    }
 
-      if (applyOffsetAndCurve) {
-        bool applyTrims = !(mode & e_perout_mode_notrims);
-        if (!applyTrims && g_model.thrTrim) {
-          auto origin = getSourceTrimOrigin(md->srcRaw);
-          if (origin == g_model.getThrottleStickTrimSource() - MIXSRC_FIRST_TRIM) {
-            applyTrims = true;
-          }
-        }
-        if (applyTrims && md->carryTrim == 0) {
-          v += getSourceTrimValue(md->srcRaw, v);
+    if (applyOffsetAndCurve) {
+      bool applyTrims = !(mode & e_perout_mode_notrims);
+      if (!applyTrims && g_model.thrTrim) {
+        auto origin = getSourceTrimOrigin(item.srcRaw);
+        if (origin == g_model.getThrottleStickTrimSource() - MIXSRC_FIRST_TRIM) {
+          applyTrims = true;
         }
       }
+      if (applyTrims && md->carryTrim == 0) {
+        v += getSourceTrimValue(item.srcRaw, v);
+      }
+    }
 
-      int32_t weight = GET_GVAR_PREC1(MD_WEIGHT(md), GV_RANGELARGE_NEG, GV_RANGELARGE, mixerCurrentFlightMode);
+    int32_t weight = item.weight;
+    if (item.flags & MIX_PLAN_WEIGHT_GVAR) {
+      weight = GET_GVAR_PREC1(MD_WEIGHT(md), GV_RANGELARGE_NEG, GV_RANGELARGE, mixerCurrentFlightMode);
       weight = calc100to256_16Bits(weight);
-      //========== SPEED ===============
-      // now its on input side, but without weight compensation. More like other remote controls
-      // lower weight causes slower movement
+    }
 
-      if (mode <= e_perout_mode_inactive_flight_mode && (md->speedUp || md->speedDown)) { // there are delay values
+    //========== SPEED ===============
+    // now its on input side, but without weight compensation. More like other remote controls
+    // lower weight causes slower movement
+
+    if (mode <= e_perout_mode_inactive_flight_mode && (item.flags & MIX_PLAN_SLOW)) { // there are delay values
 #define DEL_MULT_SHIFT 8
-        // we recale to a mult 256 higher value for calculation
-        int32_t tact = act[i];
-        int16_t diff = v - (tact>>DEL_MULT_SHIFT);
-        if (diff) {
-          // open.20.fsguruh: speed is defined in % movement per second; In menu we specify the full movement (-100% to 100%) = 200% in total
-          // the unit of the stored value is the value from md->speedUp or md->speedDown * 0.1s; e.g. value 4 means 0.4 seconds
-          // because we get a tick each 10msec, we need 100 ticks for one second
-          // the value in md->speedXXX gives the time it should take to do a full movement from -100 to 100 therefore 200%. This equals 2048 in recalculated internal range
-          if (tick10ms || !s_mixer_first_run_done) {
-            // only if already time is passed add or substract a value according the speed configured
-            int32_t rate = (int32_t) tick10ms << (DEL_MULT_SHIFT+11);  // = DEL_MULT*2048*tick10ms
-            // rate equals a full range for one second; if less time is passed rate is accordingly smaller
-            // if one second passed, rate would be 2048 (full motion)*256(recalculated weight)*100(100 ticks needed for one second)
-            int32_t currentValue = ((int32_t) v<<DEL_MULT_SHIFT);
-            if (diff > 0) {
-              if (s_mixer_first_run_done && md->speedUp > 0) {
-                // if a speed upwards is defined recalculate the new value according configured speed; the higher the speed the smaller the add value is
-                int32_t newValue = tact+rate/((int16_t)10*md->speedUp);
-                if (newValue<currentValue) currentValue = newValue; // Endposition; prevent toggling around the destination
-              }
+      // we recale to a mult 256 higher value for calculation
+      int32_t tact = mixRuntime.act[item.state];
+      int16_t diff = v - (tact>>DEL_MULT_SHIFT);
+      if (diff) {
+        // open.20.fsguruh: speed is defined in % movement per second; In menu we specify the full movement (-100% to 100%) = 200% in total
+        // the unit of the stored value is the value from md->speedUp or md->speedDown * 0.1s; e.g. value 4 means 0.4 seconds
+        // because we get a tick each 10msec, we need 100 ticks for one second
+        // the value in md->speedXXX gives the time it should take to do a full movement from -100 to 100 therefore 200%. This equals 2048 in recalculated internal range
+        if (tick10ms || !s_mixer_first_run_done) {
+          // only if already time is passed add or substract a value according the speed configured
+          int32_t rate = (int32_t) tick10ms << (DEL_MULT_SHIFT+11);  // = DEL_MULT*2048*tick10ms
+          // rate equals a full range for one second; if less time is passed rate is accordingly smaller
+          // if one second passed, rate would be 2048 (full motion)*256(recalculated weight)*100(100 ticks needed for one second)
+          int32_t currentValue = ((int32_t) v<<DEL_MULT_SHIFT);
+          if (diff > 0) {
+            if (s_mixer_first_run_done && md->speedUp > 0) {
+              // if a speed upwards is defined recalculate the new value according configured speed; the higher the speed the smaller the add value is
+              int32_t newValue = tact+rate/((int16_t)10*md->speedUp);
+              if (newValue<currentValue) currentValue = newValue; // Endposition; prevent toggling around the destination
             }
-            else {  // if is <0 because ==0 is not possible
-              if (s_mixer_first_run_done && md->speedDown > 0) {
-                // see explanation in speedUp
-                int32_t newValue = tact-rate/((int16_t)10*md->speedDown);
-                if (newValue>currentValue) currentValue = newValue; // Endposition; prevent toggling around the destination
-              }
+          }
+          else {  // if is <0 because ==0 is not possible
+            if (s_mixer_first_run_done && md->speedDown > 0) {
+              // see explanation in speedUp
+              int32_t newValue = tact-rate/((int16_t)10*md->speedDown);
+              if (newValue>currentValue) currentValue = newValue; // Endposition; prevent toggling around the destination
             }
-            act[i] = tact = currentValue;
-            // open.20.fsguruh: this implementation would save about 50 bytes code
-          } // endif tick10ms ; in case no time passed assign the old value, not the current value from source
-          v = (tact >> DEL_MULT_SHIFT);
-        }
-      }
-
-      //========== CURVES ===============
-      if (applyOffsetAndCurve && md->curve.type != CURVE_REF_DIFF && md->curve.value) {
-        v = applyCurve(v, md->curve);
+          }
+          mixRuntime.act[item.state] = tact = currentValue;
+          // open.20.fsguruh: this implementation would save about 50 bytes code
+        } // endif tick10ms ; in case no time passed assign the old value, not the current value from source
+        v = (tact >> DEL_MULT_SHIFT);
       }
+    }
 
-      //========== WEIGHT ===============
-      int32_t dv = (int32_t)v * weight;
-      dv = divRoundClosest(dv, 10);
-
-      //========== OFFSET / AFTER ===============
-      if (applyOffsetAndCurve) {
-        int32_t offset = GET_GVAR_PREC1(MD_OFFSET(md), GV_RANGELARGE_NEG, GV_RANGELARGE, mixerCurrentFlightMode);
-        if (offset) dv += divRoundClosest(calc100toRESX_16Bits(offset), 10) << 8;
-      }
+    int32_t offset = item.offset;
+    if (applyOffsetAndCurve && (item.flags & MIX_PLAN_OFFSET_GVAR)) {
+      offset = GET_GVAR_PREC1(MD_OFFSET(md), GV_RANGELARGE_NEG, GV_RANGELARGE, mixerCurrentFlightMode);
+      offset = offset ? divRoundClosest(calc100toRESX_16Bits(offset), 10) << 8 : 0;
+    }
 
-      //========== DIFFERENTIAL =========
-      if (md->curve.type == CURVE_REF_DIFF && md->curve.value) {
-        dv = applyCurve(dv, md->curve);
-      }
+    //========== CURVES / WEIGHT / OFFSET / DIFFERENTIAL / MULTIPLEX ===============
+    int32_t * ptr = &chans[item.destCh]; // Save calculating address several times
 
-      int32_t * ptr = &chans[md->destCh]; // Save calculating address several times
+    item.kernel(item, ptr, v, weight, offset, applyOffsetAndCurve);
 
-      switch (md->mltpx) {
-        case MLTPX_REPL:
-          *ptr = dv;
-          if (mode == e_perout_mode_normal) {
-            for (uint8_t m=i-1; m<MAX_MIXERS && mixAddress(m)->destCh==md->destCh; m--)
-              swOn[m].activeMix = false;
-          }
-          break;
-        case MLTPX_MUL:
-          // @@@2 we have to remove the weight factor of 256 in case of 100%; now we use the new base of 256
-          dv >>= 8;
-          dv *= *ptr;
-          dv >>= RESX_SHIFT;   // same as dv /= RESXl;
-          *ptr = dv;
-          break;
-        default: // MLTPX_ADD
-          *ptr += dv; //Mixer output add up to the line (dv + (dv>0 ? 100/2 : -100/2))/(100);
-          break;
-      } // endswitch md->mltpx
+    if (item.mltpx == MLTPX_REPL && mode == e_perout_mode_normal) {
+      for (uint8_t m=i-1; m<MAX_MIXERS && mixAddress(m)->destCh==item.destCh; m--)
+        swOn[m].activeMix = false;
+    }
 #ifdef PREVENT_ARITHMETIC_OVERFLOW
 /*
-      // a lot of assumptions must be true, for this kind of check; not really worth for only 4 bytes flash savings
-      // this solution would save again 4 bytes flash
-      int8_t testVar=(*ptr<<1)>>24;
-      if ( (testVar!=-1) && (testVar!=0 ) ) {
-        // this devices by 64 which should give a good balance between still over 100% but lower then 32x100%; should be OK
-        *ptr >>= 6;  // this is quite tricky, reduces the value a lot but should be still over 100% and reduces flash need
-      } */
-
-
-      PACK( union u_int16int32_t {
-        struct {
-          int16_t lo;
-          int16_t hi;
-        } words_t;
-        int32_t dword;
-      });
-
-      u_int16int32_t tmp;
-      tmp.dword=*ptr;
-
-      if (tmp.dword<0) {
-        if ((tmp.words_t.hi&0xFF80)!=0xFF80) tmp.words_t.hi=0xFF86; // set to min nearly
-      }
-      else {
-        if ((tmp.words_t.hi|0x007F)!=0x007F) tmp.words_t.hi=0x0079; // set to max nearly
-      }
-      *ptr = tmp.dword;
-      // this implementation saves 18bytes flash
+    // a lot of assumptions must be true, for this kind of check; not really worth for only 4 bytes flash savings
+    // this solution would save again 4 bytes flash
+    int8_t testVar=(*ptr<<1)>>24;
+    if ( (testVar!=-1) && (testVar!=0 ) ) {
+      // this devices by 64 which should give a good balance between still over 100% but lower then 32x100%; should be OK
+      *ptr >>= 6;  // this is quite tricky, reduces the value a lot but should be still over 100% and reduces flash need
+    } */
+
+
+    PACK( union u_int16int32_t {
+      struct {
+        int16_t lo;
+        int16_t hi;
+      } words_t;
+      int32_t dword;
+    });
+
+    u_int16int32_t tmp;
+    tmp.dword=*ptr;
+
+    if (tmp.dword<0) {
+      if ((tmp.words_t.hi&0xFF80)!=0xFF80) tmp.words_t.hi=0xFF86; // set to min nearly
+    }
+    else {
+      if ((tmp.words_t.hi|0x007F)!=0x007F) tmp.words_t.hi=0x0079; // set to max nearly
+    }
+    *ptr = tmp.dword;
+    // this implementation saves 18bytes flash
 
 /*      dv=*ptr>>8;
-      if (dv>(32767-RESXl)) {
-        *ptr=(32767-RESXl)<<8;
-      } else if (dv<(-32767+RESXl)) {
-        *ptr=(-32767+RESXl)<<8;
-      }*/
-      // *ptr=limit( int32_t(int32_t(-1)<<23), *ptr, int32_t(int32_t(1)<<23));  // limit code cost 72 bytes
-      // *ptr=limit( int32_t((-32767+RESXl)<<8), *ptr, int32_t((32767-RESXl)<<8));  // limit code cost 80 bytes
+    if (dv>(32767-RESXl)) {
+      *ptr=(32767-RESXl)<<8;
+    } else if (dv<(-32767+RESXl)) {
+      *ptr=(-32767+RESXl)<<8;
+    }*/
+    // *ptr=limit( int32_t(int32_t(-1)<<23), *ptr, int32_t(int32_t(1)<<23));  // limit code cost 72 bytes
+    // *ptr=limit( int32_t((-32767+RESXl)<<8), *ptr, int32_t((32767-RESXl)<<8));  // limit code cost 80 bytes
 #endif
 
-    } //endfor mixers
+  } //endfor mixers
+
+  mixWarning = lv_mixWarning;
+}
 
-    tick10ms = 0;
-    dirtyChannels &= passDirtyChannels;
+void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
+{
+  evalFlightModeInputs(mode, tick10ms);
+  memclear(chans, sizeof(chans)); // all outputs to 0
+  evalFlightModeChannels(mode, tick10ms, (bitfield_channels_t)-1);
+}
 
-  } while (++pass < 5 && dirtyChannels);
+// Flight modes fade
+//
+// The active flight mode is evaluated first, then the other fading flight
+// modes only re-evaluate the channels whose mix lines give a different result
+// in this flight mode: lines enabled in one mode and not in the other, GVars,
+// delays, slow, trims, or inputs with a different value. The other channels
+// are blended with the values of the active flight mode.
+struct FadeReference {
+  int32_t chans[MAX_OUTPUT_CHANNELS];
+  int16_t anas[MAX_INPUTS];
+  int8_t virtualInputsTrims[MAX_INPUTS];
+  int16_t trims[MAX_TRIMS];
+#if defined(HELI)
+  int16_t cyc_anas[3];
+#endif
+  uint8_t mixWarning;
+};
 
-  mixWarning = lv_mixWarning;
+static FadeReference fadeReference;
+
+static void saveFadeReference()
+{
+  memcpy(fadeReference.chans, chans, sizeof(chans));
+  memcpy(fadeReference.anas, anas, sizeof(anas));
+  memcpy(fadeReference.virtualInputsTrims, virtualInputsTrims, sizeof(virtualInputsTrims));
+  memcpy(fadeReference.trims, trims, sizeof(trims));
+#if defined(HELI)
+  memcpy(fadeReference.cyc_anas, cyc_anas, sizeof(cyc_anas));
+#endif
+  fadeReference.mixWarning = mixWarning;
+}
+
+// leave the mixer state of the active flight mode
+static void restoreFadeReference()
+{
+  memcpy(anas, fadeReference.anas, sizeof(anas));
+  memcpy(virtualInputsTrims, fadeReference.virtualInputsTrims, sizeof(virtualInputsTrims));
+  memcpy(trims, fadeReference.trims, sizeof(trims));
+#if defined(HELI)
+  memcpy(cyc_anas, fadeReference.cyc_anas, sizeof(cyc_anas));
+#endif
+  mixWarning = fadeReference.mixWarning;
+}
+
+static bool isMixSourceUnchanged(mixsrc_t srcRaw)
+{
+  if (srcRaw >= MIXSRC_FIRST_INPUT && srcRaw <= MIXSRC_LAST_INPUT) {
+    uint8_t input = srcRaw - MIXSRC_FIRST_INPUT;
+    return anas[input] == fadeReference.anas[input] &&
+           virtualInputsTrims[input] == fadeReference.virtualInputsTrims[input];
+  }
+#if defined(HELI)
+  if (srcRaw >= MIXSRC_FIRST_HELI && srcRaw <= MIXSRC_LAST_HELI) {
+    return cyc_anas[srcRaw - MIXSRC_FIRST_HELI] == fadeReference.cyc_anas[srcRaw - MIXSRC_FIRST_HELI];
+  }
+#endif
+  return true;
+}
+
+// channels which give the same result in the current (inactive) flight mode
+// as in the active one
+static bitfield_channels_t getFadeSharedChannels(uint8_t activeFlightMode)
+{
+  bitfield_channels_t shared = (bitfield_channels_t)-1;
+
+  for (uint8_t p = 0; p < mixPlan.count; p++) {
+    const MixPlanItem & item = mixPlan.items[p];
+    const MixData * md = item.md;
+    bitfield_channels_t destMask = (bitfield_channels_t)1 << item.destCh;
+
+    if (!(shared & destMask))
+      continue;
+
+    bool enabled = !(md->flightModes & (1 << mixerCurrentFlightMode));
+    bool activeEnabled = !(md->flightModes & (1 << activeFlightMode));
+    bool unchanged = (item.flags & MIX_PLAN_FM_INVARIANT) && enabled == activeEnabled &&
+                     isMixSourceUnchanged(item.srcRaw);
+
+    if (unchanged && md->carryTrim == 0) {
+      auto origin = getSourceTrimOrigin(item.srcRaw);
+      unchanged = (origin < 0 || trims[origin] == fadeReference.trims[origin]);
+    }
+
+    if (unchanged && (item.flags & MIX_PLAN_SRC_CH_READY)) {
+      unchanged = shared & ((bitfield_channels_t)1 << (item.srcRaw - MIXSRC_FIRST_CH));
+    }
+
+    if (!unchanged)
+      shared &= ~destMask;
+  }
+
+  return shared;
 }
 
 
@@ -1049,10 +1292,20 @@ void evalMixes(uint8_t tick10ms)
   int32_t weight = 0;
   if (flightModesFade) {
     memclear(sum_chans512, sizeof(sum_chans512));
+    mixerCurrentFlightMode = fm;
+    evalFlightModeMixes(e_perout_mode_normal, tick10ms);
+    saveFadeReference();
     for (uint8_t p=0; p<MAX_FLIGHT_MODES; p++) {
       if (flightModesFade & (0x01 << p)) {
-        mixerCurrentFlightMode = p;
-        evalFlightModeMixes(p==fm ? e_perout_mode_normal : e_perout_mode_inactive_flight_mode, p==fm ? tick10ms : 0);
+        if (p != fm) {
+          mixerCurrentFlightMode = p;
+          evalFlightModeInputs(e_perout_mode_inactive_flight_mode, 0);
+          memcpy(chans, fadeReference.chans, sizeof(chans));
+          evalFlightModeChannels(e_perout_mode_inactive_flight_mode, 0, ~getFadeSharedChannels(fm));
+        }
+        else {
+          memcpy(chans, fadeReference.chans, sizeof(chans));
+        }
         for (uint8_t i=0; i<MAX_OUTPUT_CHANNELS; i++)
           sum_chans512[i] += limit<int32_t>(-0x6fff, chans[i] >> 4, 0x6fff) * fp_act[p];
         weight += fp_act[p];
@@ -1060,6 +1313,8 @@ void evalMixes(uint8_t tick10ms)
     }
     assert(weight);
     mixerCurrentFlightMode = fm;
+    restoreFadeReference();
+    memcpy(chans, fadeReference.chans, sizeof(chans));
   }
   else {
     mixerCurrentFlightMode = fm;
@@ -1082,6 +1337,9 @@ void evalMixes(uint8_t tick10ms)
   }
 
   //========== LIMITS ===============
+  int32_t limitsInput[MAX_OUTPUT_CHANNELS];
+  int16_t limitsOutput[MAX_OUTPUT_CHANNELS];
+
   for (uint8_t i=0; i<MAX_OUTPUT_CHANNELS; i++) {
     // chans[i] holds data from mixer.   chans[i] = v*weight => 1024*256
     // later we multiply by the limit (up to 100) and then we need to normalize
@@ -1092,11 +1350,20 @@ void evalMixes(uint8_t tick10ms)
 
     ex_chans[i] = q / 256;
 
-    int16_t value = applyLimits(i, q);  // applyLimits will remove the 256 100% basis
+    limitsInput[i] = q;
+  }
+
+  applyLimitsPlan(limitsInput, limitsOutput);  // applyLimits will remove the 256 100% basis
 
-    channelOutputs[i] = value;  // copy consistent word to int-level
+  for (uint8_t i=0; i<MAX_OUTPUT_CHANNELS; i++) {
+    channelOutputs[i] = limitsOutput[i];  // copy consistent word to int-level
   }
 
+  channelOutputsSampleTime = adcGetSampleTime();
+  channelOutputsTime = getTmr2MHz();
+
+  mixerOutputsPublish();
+
   if (tick10ms && flightModesFade) {
     uint16_t tick_delta = delta * tick10ms;
     for (uint8_t p=0; p<MAX_FLIGHT_MODES; p++) {
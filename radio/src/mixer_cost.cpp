@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#include "opentx.h"
+#include "mixer_cost.h"
+#include "mixer_scheduler.h"
+
+#if defined(STM32F4)
+  #define MIXER_COST_CPU_PERCENT    MIXER_COST_CPU_PERCENT_STM32F4
+#else
+  #define MIXER_COST_CPU_PERCENT    MIXER_COST_CPU_PERCENT_STM32F2
+#endif
+
+static uint32_t getCurveCost(const CurveRef & curve)
+{
+  if (!curve.value)
+    return 0;
+  if (curve.type != CURVE_REF_CUSTOM)
+    return MIXER_COST_CURVE;
+  int8_t index = abs(curve.value) - 1;
+  if (index >= MAX_CURVES)
+    return MIXER_COST_CURVE;
+  return MIXER_COST_CUSTOM_CURVE + (g_model.curves[index].smooth ? MIXER_COST_SMOOTH_CURVE : 0);
+}
+
+static uint32_t getFunctionsCost(const CustomFunctionData * functions)
+{
+  uint32_t result = 0;
+  for (uint8_t i = 0; i < MAX_SPECIAL_FUNCTIONS; i++) {
+    if (CFN_SWITCH(&functions[i]))
+      result += MIXER_COST_FUNCTION;
+  }
+  return result;
+}
+
+static uint16_t computeMixerCost()
+{
+  uint32_t result = MIXER_COST_BASE;
+
+  for (uint8_t i = 0; i < MAX_EXPOS; i++) {
+    ExpoData * ed = expoAddress(i);
+    if (!EXPO_VALID(ed))
+      break;
+    result += MIXER_COST_INPUT_LINE + getCurveCost(ed->curve);
+  }
+
+  for (uint8_t i = 0; i < MAX_MIXERS; i++) {
+    MixData * md = mixAddress(i);
+    if (md->srcRaw == 0)
+      continue;
+    result += MIXER_COST_MIX_LINE + getCurveCost(md->curve);
+    if (md->speedUp || md->speedDown || md->delayUp || md->delayDown)
+      result += MIXER_COST_SLOW_DELAY;
+  }
+
+  for (uint8_t i = 0; i < MAX_LOGICAL_SWITCHES; i++) {
+    if (lswAddress(i)->func)
+      result += MIXER_COST_LOGICAL_SWITCH;
+  }
+
+  result += getFunctionsCost(g_model.customFn);
+  if (radioGFEnabled())
+    result += getFunctionsCost(g_eeGeneral.customFn);
+
+  return result * MIXER_COST_CPU_PERCENT / 1000;
+}
+
+static struct {
+  uint16_t revision;  // storageRevision the estimate was computed from
+  uint16_t value;
+} mixerCost;
+
+uint16_t mixerCostEstimate()
+{
+  if (mixerCost.revision != storageRevision) {
+    mixerCost.value = computeMixerCost();
+    mixerCost.revision = storageRevision;
+  }
+  return mixerCost.value;
+}
+
+bool isMixerCostHigh()
+{
+  return (uint32_t)mixerCostEstimate() * 100 >= (uint32_t)getMixerSchedulerPeriod() * MIXER_COST_HIGH_PERCENT;
+}
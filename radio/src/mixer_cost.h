@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#pragma once
+
+#include <inttypes.h>
+
+// Mixer cost estimate
+//
+// A static estimate of the duration of one mixer run, computed from the
+// model contents (inputs, mix lines, curves, slows / delays, logical switches
+// and special functions) with rough per item costs of the board CPU. It
+// lets the model editor tell how close the mixer gets to the period of the
+// active RF module before the model is flown. Lua mix scripts run in their
+// own task and are not part of it.
+//
+// Companion includes this file to print the same estimate for the models it
+// edits, so it should only hold plain defines and declarations.
+
+// Uncalibrated placeholder costs, in 0.1us on a 120MHz STM32F2. They are
+// guesses and were not measured on any board, nor is the STM32F4 factor
+// below: the estimate only tells models apart, it is no measured duration.
+// Per board values are to be taken with the mixer-bench and the Tmix
+// statistics of each target.
+#define MIXER_COST_BASE             600   // sticks, limits, timers, telemetry
+#define MIXER_COST_INPUT_LINE       25
+#define MIXER_COST_MIX_LINE         40
+#define MIXER_COST_CURVE            15    // expo, function or differential
+#define MIXER_COST_CUSTOM_CURVE     25
+#define MIXER_COST_SMOOTH_CURVE     20    // added to a custom curve
+#define MIXER_COST_SLOW_DELAY       10
+#define MIXER_COST_LOGICAL_SWITCH   10
+#define MIXER_COST_FUNCTION         5     // special function with a switch set
+
+// CPU speed of the board compared to the STM32F2, in % (placeholders too)
+#define MIXER_COST_CPU_PERCENT_STM32F2  100
+#define MIXER_COST_CPU_PERCENT_STM32F4  70
+
+// the estimate is high above this part of the mixer period, in %
+#define MIXER_COST_HIGH_PERCENT     80
+
+// Estimated duration of a mixer run, in us
+uint16_t mixerCostEstimate();
+
+// Whether the estimate is close to the current mixer period
+bool isMixerCostHigh();
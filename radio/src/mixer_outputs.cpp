@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#include "opentx.h"
+#include "switches.h"
+#include "mixer_outputs.h"
+
+static_assert(MAX_LOGICAL_SWITCHES <= 64, "MAX_LOGICAL_SWITCHES too big for uint64_t masks");
+
+static MixerOutputs buffers[2];
+
+// incremented by each publication, its low bit is the published buffer
+static volatile uint32_t sequence = 0;
+
+static MixerOutputs uiOutputs;
+
+void mixerOutputsPublish()
+{
+  uint32_t next = sequence + 1;
+  MixerOutputs & outputs = buffers[next & 1];
+
+  outputs.sampleTime = channelOutputsSampleTime;
+  memcpy(outputs.channels, channelOutputs, sizeof(outputs.channels));
+  memcpy(outputs.mixes, ex_chans, sizeof(outputs.mixes));
+  memcpy(outputs.inputs, anas, sizeof(outputs.inputs));
+
+  uint64_t logicalSwitches = 0;
+  for (uint8_t i = 0; i < MAX_LOGICAL_SWITCHES; i++) {
+    if (getSwitch(SWSRC_FIRST_LOGICAL_SWITCH + i))
+      logicalSwitches |= (uint64_t)1 << i;
+  }
+  outputs.logicalSwitches = logicalSwitches;
+
+  // the buffer must be complete before it is published
+  __sync_synchronize();
+  sequence = next;
+}
+
+uint32_t mixerOutputsRead(MixerOutputs & outputs)
+{
+  uint32_t seq;
+  do {
+    seq = sequence;
+    __sync_synchronize();
+    outputs = buffers[seq & 1];
+    __sync_synchronize();
+    // the mixer only writes into the buffer being read after having
+    // published the other one, which changes the sequence number
+  } while (seq != sequence);
+  return seq;
+}
+
+void mixerOutputsRefresh()
+{
+  mixerOutputsRead(uiOutputs);
+}
+
+const MixerOutputs & mixerOutputs()
+{
+  return uiOutputs;
+}
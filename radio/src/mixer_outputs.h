@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#pragma once
+
+#include "opentx.h"
+
+// Mixer outputs publication
+//
+// The mixer task publishes a snapshot of its outputs once per cycle, at the
+// end of evalMixes(). Consumers in other tasks (UI, widgets, Lua, logs,
+// simulator) read the snapshot instead of the mixer globals, so they always
+// get a consistent view of one cycle and never have to lock the mixer.
+//
+// The snapshot is double buffered behind a sequence number (a seqlock): the
+// mixer fills the buffer not being published and then publishes it with a
+// single store of the sequence number, without ever waiting for readers. A
+// reader copies the published buffer and retries if the mixer published
+// again in the meantime.
+
+struct MixerOutputs {
+  uint16_t sampleTime;                    // ADC sample the outputs come from
+  int16_t channels[MAX_OUTPUT_CHANNELS];  // channelOutputs (after limits)
+  int16_t mixes[MAX_OUTPUT_CHANNELS];     // ex_chans (before limits)
+  int16_t inputs[MAX_INPUTS];             // anas
+  uint64_t logicalSwitches;               // one bit per logical switch
+};
+
+// Publish the outputs of the last mixer run (mixer task only)
+void mixerOutputsPublish();
+
+// Copy the last published outputs, returns their sequence number
+uint32_t mixerOutputsRead(MixerOutputs & outputs);
+
+// UI task snapshot, refreshed once per UI cycle so that all the screens,
+// widgets and Lua scripts drawn during the cycle show the same values
+void mixerOutputsRefresh();
+const MixerOutputs & mixerOutputs();
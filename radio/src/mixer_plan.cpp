@@ -0,0 +1,390 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "mixer_plan.h"
+
+MixPlan mixPlan;
+MixRuntime mixRuntime;
+
+static bool isGVarRef(int16_t value)
+{
+#if defined(GVARS)
+  return GV_IS_GV_VALUE(value, GV_RANGELARGE_NEG, GV_RANGELARGE);
+#else
+  return false;
+#endif
+}
+
+static bool isFlightModeInvariantSource(mixsrc_t srcRaw)
+{
+  // trims, logical switches and GVars have per flight mode values
+  return !(srcRaw >= MIXSRC_FIRST_TRIM && srcRaw <= MIXSRC_LAST_TRIM) &&
+         !(srcRaw >= MIXSRC_FIRST_LOGICAL_SWITCH && srcRaw <= MIXSRC_LAST_LOGICAL_SWITCH) &&
+         !(srcRaw >= MIXSRC_FIRST_GVAR && srcRaw <= MIXSRC_LAST_GVAR);
+}
+
+static bool isFlightModeInvariantSwitch(swsrc_t swtch)
+{
+  swtch = abs(swtch);
+  return swtch == SWSRC_NONE || (swtch >= SWSRC_FIRST_SWITCH && swtch <= SWSRC_LAST_SWITCH);
+}
+
+static bool isFlightModeInvariantCurve(const CurveRef & curve)
+{
+#if defined(GVARS)
+  if (curve.type == CURVE_REF_DIFF || curve.type == CURVE_REF_EXPO)
+    return !GV_IS_GV_VALUE(curve.value, -100, 100);
+#endif
+  return true;
+}
+
+template <bool CURVE, bool DIFF, uint8_t MLTPX>
+static void mixKernel(const MixPlanItem & item, int32_t * chan, getvalue_t v,
+                      int32_t weight, int32_t offset, bool applyOffsetAndCurve)
+{
+  if (CURVE && applyOffsetAndCurve)
+    v = applyCurve(v, item.md->curve);
+
+  int32_t dv = (int32_t)v * weight;
+  dv = divRoundClosest(dv, 10);
+
+  if (applyOffsetAndCurve)
+    dv += offset;
+
+  if (DIFF)
+    dv = applyCurve(dv, item.md->curve);
+
+  if (MLTPX == MLTPX_REPL) {
+    *chan = dv;
+  }
+  else if (MLTPX == MLTPX_MUL) {
+    // @@@2 we have to remove the weight factor of 256 in case of 100%; now we use the new base of 256
+    dv >>= 8;
+    dv *= *chan;
+    dv >>= RESX_SHIFT;   // same as dv /= RESXl;
+    *chan = dv;
+  }
+  else {
+    *chan += dv;
+  }
+}
+
+#define MIX_KERNELS(curve, diff) \
+  { mixKernel<curve, diff, MLTPX_ADD>, mixKernel<curve, diff, MLTPX_MUL>, mixKernel<curve, diff, MLTPX_REPL> }
+
+static const MixKernel mixKernels[3][3] = {
+  MIX_KERNELS(false, false),
+  MIX_KERNELS(true, false),
+  MIX_KERNELS(false, true),
+};
+
+static MixKernel getMixKernel(uint16_t flags, uint8_t mltpx)
+{
+  uint8_t curve = (flags & MIX_PLAN_CURVE) ? 1 : ((flags & MIX_PLAN_DIFF) ? 2 : 0);
+  return mixKernels[curve][mltpx <= MLTPX_REPL ? mltpx : MLTPX_ADD];
+}
+
+static void mixPlanCompileItem(MixPlanItem & item, uint8_t index)
+{
+  MixData * md = mixAddress(index);
+
+  item.md = md;
+  item.index = index;
+  item.srcRaw = md->srcRaw;
+  item.destCh = md->destCh;
+  item.mltpx = md->mltpx;
+  item.flags = 0;
+
+  if (md->flightModes != 0 || md->swtch)
+    item.flags |= MIX_PLAN_CONDITION;
+
+  if (md->srcRaw >= MIXSRC_FIRST_TRAINER && md->srcRaw <= MIXSRC_LAST_TRAINER)
+    item.flags |= MIX_PLAN_SRC_TRAINER;
+
+#if defined(LUA_MODEL_SCRIPTS)
+  if (md->srcRaw >= MIXSRC_FIRST_LUA && md->srcRaw <= MIXSRC_LAST_LUA)
+    item.flags |= MIX_PLAN_SRC_LUA;
+#endif
+
+  if (md->srcRaw >= MIXSRC_FIRST_CH && md->srcRaw <= MIXSRC_LAST_CH)
+    item.flags |= MIX_PLAN_SRC_CH;
+
+  if (md->delayUp || md->delayDown)
+    item.flags |= MIX_PLAN_DELAY;
+
+  if (md->speedUp || md->speedDown)
+    item.flags |= MIX_PLAN_SLOW;
+
+  if (md->curve.value) {
+    item.flags |= (md->curve.type == CURVE_REF_DIFF ? MIX_PLAN_DIFF : MIX_PLAN_CURVE);
+  }
+
+  if (md->mixWarn)
+    item.flags |= MIX_PLAN_MIX_WARN;
+
+  // weight and offset are resolved here unless they come from a GVar,
+  // which depends on the flight mode being evaluated
+  item.weight = 0;
+  if (isGVarRef(MD_WEIGHT(md))) {
+    item.flags |= MIX_PLAN_WEIGHT_GVAR;
+  }
+  else {
+    int32_t weight = GET_GVAR_PREC1(MD_WEIGHT(md), GV_RANGELARGE_NEG, GV_RANGELARGE, 0);
+    item.weight = calc100to256_16Bits(weight);
+  }
+
+  item.offset = 0;
+  if (isGVarRef(MD_OFFSET(md))) {
+    item.flags |= MIX_PLAN_OFFSET_GVAR;
+  }
+  else {
+    int32_t offset = GET_GVAR_PREC1(MD_OFFSET(md), GV_RANGELARGE_NEG, GV_RANGELARGE, 0);
+    if (offset) item.offset = divRoundClosest(calc100toRESX_16Bits(offset), 10) << 8;
+  }
+
+  item.kernel = getMixKernel(item.flags, item.mltpx);
+
+  // delays and slow lines are evaluated differently in the inactive flight
+  // modes of a fade
+  if (!(item.flags & (MIX_PLAN_WEIGHT_GVAR | MIX_PLAN_OFFSET_GVAR | MIX_PLAN_DELAY | MIX_PLAN_SLOW)) &&
+      isFlightModeInvariantSource(md->srcRaw) && isFlightModeInvariantSwitch(md->swtch) &&
+      isFlightModeInvariantCurve(md->curve))
+    item.flags |= MIX_PLAN_FM_INVARIANT;
+}
+
+static bool isChannelSource(MixData * md)
+{
+  return md->srcRaw >= MIXSRC_FIRST_CH && md->srcRaw <= MIXSRC_LAST_CH &&
+         md->srcRaw - MIXSRC_FIRST_CH != md->destCh;
+}
+
+// Sort the channels so that each channel comes after the channels it reads,
+// the loops are broken at their lowest channel
+static uint8_t mixPlanSortChannels(uint8_t * order, const uint8_t * lines, uint8_t count)
+{
+  bitfield_channels_t used = 0;
+  bitfield_channels_t sources[MAX_OUTPUT_CHANNELS];  // channels read by each channel
+  bitfield_channels_t reach[MAX_OUTPUT_CHANNELS];    // same, transitively
+  bitfield_channels_t loops[MAX_OUTPUT_CHANNELS];    // channels in the same loop
+
+  memclear(sources, sizeof(sources));
+  for (uint8_t i = 0; i < count; i++) {
+    MixData * md = mixAddress(lines[i]);
+    used |= (bitfield_channels_t)1 << md->destCh;
+    if (isChannelSource(md))
+      sources[md->destCh] |= (bitfield_channels_t)1 << (md->srcRaw - MIXSRC_FIRST_CH);
+  }
+
+  memcpy(reach, sources, sizeof(reach));
+  bool changed;
+  do {
+    changed = false;
+    for (uint8_t ch = 0; ch < MAX_OUTPUT_CHANNELS; ch++) {
+      bitfield_channels_t r = reach[ch];
+      for (uint8_t src = 0; src < MAX_OUTPUT_CHANNELS; src++) {
+        if (reach[ch] & ((bitfield_channels_t)1 << src))
+          r |= reach[src];
+      }
+      if (r != reach[ch]) {
+        reach[ch] = r;
+        changed = true;
+      }
+    }
+  } while (changed);
+
+  for (uint8_t ch = 0; ch < MAX_OUTPUT_CHANNELS; ch++) {
+    loops[ch] = 0;
+    mixPlan.channelLoop[ch] = 0;
+    if (reach[ch] & ((bitfield_channels_t)1 << ch)) {
+      for (uint8_t other = 0; other < MAX_OUTPUT_CHANNELS; other++) {
+        if ((reach[ch] & ((bitfield_channels_t)1 << other)) && (reach[other] & ((bitfield_channels_t)1 << ch))) {
+          loops[ch] |= (bitfield_channels_t)1 << other;
+        }
+      }
+      mixPlan.channelLoop[ch] = __builtin_ctz(loops[ch]) + 1;
+    }
+  }
+
+  // channels without mix lines are 0 from the start of the cycle
+  bitfield_channels_t done = ~used;
+  uint8_t result = 0;
+  while (result < __builtin_popcount(used)) {
+    uint8_t next = MAX_OUTPUT_CHANNELS;
+    for (uint8_t ch = 0; ch < MAX_OUTPUT_CHANNELS && next == MAX_OUTPUT_CHANNELS; ch++) {
+      if (!(done & ((bitfield_channels_t)1 << ch)) && !(sources[ch] & ~done))
+        next = ch;
+    }
+    for (uint8_t ch = 0; ch < MAX_OUTPUT_CHANNELS && next == MAX_OUTPUT_CHANNELS; ch++) {
+      if (!(done & ((bitfield_channels_t)1 << ch)) && !(sources[ch] & ~done & ~loops[ch]))
+        next = ch;
+    }
+    if (next == MAX_OUTPUT_CHANNELS)
+      break;
+    done |= (bitfield_channels_t)1 << next;
+    order[result++] = next;
+  }
+
+  return result;
+}
+
+void mixRuntimeReset()
+{
+  memclear(mixRuntime.act, sizeof(mixRuntime.act));
+  memclear(mixRuntime.delay, sizeof(mixRuntime.delay));
+  memclear(mixRuntime.now, sizeof(mixRuntime.now));
+  memclear(mixRuntime.prev, sizeof(mixRuntime.prev));
+}
+
+// Give a runtime slot to each line which needs one, in the plan order, and
+// move the state of the lines which already had one to their new slot
+static void mixRuntimeCompile()
+{
+  uint8_t source[MAX_MIXERS];  // previous slot of each slot
+  uint64_t used = 0;           // previous slots moved to a new slot
+  uint8_t count = 0;
+
+  for (uint8_t p = 0; p < mixPlan.count; p++) {
+    MixPlanItem & item = mixPlan.items[p];
+    if (!(item.flags & (MIX_PLAN_DELAY | MIX_PLAN_SLOW)))
+      continue;
+    source[count] = MAX_MIXERS;
+    for (uint8_t s = 0; s < mixRuntime.count; s++) {
+      if (mixRuntime.lines[s] == item.index) {
+        source[count] = s;
+        used |= (uint64_t)1 << s;
+        break;
+      }
+    }
+    item.state = count++;
+  }
+
+  for (uint8_t p = 0; p < mixPlan.count; p++) {
+    const MixPlanItem & item = mixPlan.items[p];
+    if (item.flags & (MIX_PLAN_DELAY | MIX_PLAN_SLOW))
+      mixRuntime.lines[item.state] = item.index;
+  }
+
+  // complete the moves with the unused previous slots, so that they
+  // form a permutation which can be applied in place
+  uint8_t unused = 0;
+  uint64_t fresh = 0;
+  for (uint8_t s = 0; s < MAX_MIXERS; s++) {
+    if (s >= count || source[s] == MAX_MIXERS) {
+      while (used & ((uint64_t)1 << unused))
+        unused++;
+      used |= (uint64_t)1 << unused;
+      source[s] = unused;
+      fresh |= (uint64_t)1 << s;
+    }
+  }
+
+  uint64_t done = 0;
+  for (uint8_t s = 0; s < MAX_MIXERS; s++) {
+    if (done & ((uint64_t)1 << s))
+      continue;
+    int32_t act = mixRuntime.act[s];
+    uint16_t delay = mixRuntime.delay[s];
+    int16_t now = mixRuntime.now[s];
+    int16_t prev = mixRuntime.prev[s];
+    uint8_t slot = s;
+    while (source[slot] != s) {
+      uint8_t from = source[slot];
+      mixRuntime.act[slot] = mixRuntime.act[from];
+      mixRuntime.delay[slot] = mixRuntime.delay[from];
+      mixRuntime.now[slot] = mixRuntime.now[from];
+      mixRuntime.prev[slot] = mixRuntime.prev[from];
+      done |= (uint64_t)1 << slot;
+      slot = from;
+    }
+    mixRuntime.act[slot] = act;
+    mixRuntime.delay[slot] = delay;
+    mixRuntime.now[slot] = now;
+    mixRuntime.prev[slot] = prev;
+    done |= (uint64_t)1 << slot;
+  }
+
+  for (uint8_t s = 0; s < count; s++) {
+    if (fresh & ((uint64_t)1 << s)) {
+      mixRuntime.act[s] = 0;
+      mixRuntime.delay[s] = 0;
+      mixRuntime.now[s] = mixRuntime.prev[s] = 0;
+    }
+  }
+
+  mixRuntime.count = count;
+}
+
+void mixPlanCompile()
+{
+  uint8_t lines[MAX_MIXERS];
+  uint8_t count = 0;
+
+  for (uint8_t i = 0; i < MAX_MIXERS; i++) {
+    // lines which are not evaluated anymore should not look active
+    swOn[i].activeMix = false;
+  }
+
+  for (uint8_t i = 0; i < MAX_MIXERS; i++) {
+    MixData * md = mixAddress(i);
+    if (md->srcRaw == 0)
+#if defined(COLORLCD)
+      continue;
+#else
+      break;
+#endif
+    lines[count++] = i;
+  }
+
+  uint8_t order[MAX_OUTPUT_CHANNELS];
+  uint8_t channels = mixPlanSortChannels(order, lines, count);
+  bitfield_channels_t done = 0;
+
+  uint8_t p = 0;
+  for (uint8_t c = 0; c < channels; c++) {
+    uint8_t ch = order[c];
+    uint8_t first = p;
+    for (uint8_t i = 0; i < count; i++) {
+      MixData * md = mixAddress(lines[i]);
+      if (md->destCh != ch)
+        continue;
+      MixPlanItem & item = mixPlan.items[p++];
+      mixPlanCompileItem(item, lines[i]);
+      if (p == first + 1)
+        item.flags |= MIX_PLAN_FIRST_LINE;
+      if (isChannelSource(md) && (done & ((bitfield_channels_t)1 << (md->srcRaw - MIXSRC_FIRST_CH))))
+        item.flags |= MIX_PLAN_SRC_CH_READY;
+    }
+    done |= (bitfield_channels_t)1 << ch;
+  }
+
+  mixPlan.count = p;
+  mixRuntimeCompile();
+  mixPlan.revision = storageRevision;
+}
+
+bool isMixInChannelLoop(uint8_t index)
+{
+  MixData * md = mixAddress(index);
+  if (!isChannelSource(md) || md->destCh >= MAX_OUTPUT_CHANNELS)
+    return false;
+  uint8_t loop = mixPlan.channelLoop[md->destCh];
+  return loop && loop == mixPlan.channelLoop[md->srcRaw - MIXSRC_FIRST_CH];
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include "opentx.h"
+
+// The mix plan is a compact, pre-decoded copy of the model mix table.
+// It is compiled whenever the model is loaded or edited, so that the mixer
+// hot loop only visits the lines actually used by the model and does not
+// have to decode flight mode masks, switches, GVars and curves each cycle.
+//
+// The lines are grouped by destination channel, in the topological order of
+// the channels used as sources by other channels, so that the mixer computes
+// each channel after the channels it depends on in a single pass. When the
+// channels form a loop, the line which closes the loop uses the value of its
+// source channel from the previous cycle.
+
+enum MixPlanFlags {
+  MIX_PLAN_FIRST_LINE  = (1 << 0), // first line of its destination channel
+  MIX_PLAN_CONDITION   = (1 << 1), // flight modes and/or switch condition
+  MIX_PLAN_SRC_TRAINER = (1 << 2), // source is a trainer channel
+  MIX_PLAN_SRC_LUA     = (1 << 3), // source is a Lua mix script output
+  MIX_PLAN_SRC_CH      = (1 << 4), // source is another output channel
+  MIX_PLAN_DELAY       = (1 << 5), // delay up and/or down
+  MIX_PLAN_SLOW        = (1 << 6), // slow up and/or down
+  MIX_PLAN_CURVE       = (1 << 7), // curve / expo / function applied on source
+  MIX_PLAN_DIFF        = (1 << 8), // differential applied after weight
+  MIX_PLAN_WEIGHT_GVAR = (1 << 9), // weight resolved at runtime from a GVar
+  MIX_PLAN_OFFSET_GVAR = (1 << 10), // offset resolved at runtime from a GVar
+  MIX_PLAN_MIX_WARN    = (1 << 11), // mix warning configured
+  MIX_PLAN_SRC_CH_READY = (1 << 12), // source channel already computed in this cycle
+  MIX_PLAN_FM_INVARIANT = (1 << 13), // same result in all flight modes when its source value is
+};
+
+struct MixPlanItem;
+
+// Applies curve, weight, offset, differential and multiplex of a mix line to
+// its destination channel. Kernels are specialized at compile time for each
+// combination of these features, so that each line runs without the branches
+// of the features it does not use.
+typedef void (*MixKernel)(const MixPlanItem & item, int32_t * chan, getvalue_t v,
+                          int32_t weight, int32_t offset, bool applyOffsetAndCurve);
+
+struct MixPlanItem {
+  MixKernel kernel;
+  MixData * md;       // mix line in g_model
+  mixsrc_t srcRaw;
+  uint16_t flags;
+  uint8_t index;      // mix line index
+  uint8_t destCh;
+  uint8_t mltpx;
+  uint8_t state;      // slot in mixRuntime (only with MIX_PLAN_DELAY or MIX_PLAN_SLOW)
+  int16_t weight;     // weight scaled to 256 (only without MIX_PLAN_WEIGHT_GVAR)
+  int32_t offset;     // offset scaled to RESX << 8 (only without MIX_PLAN_OFFSET_GVAR)
+};
+
+struct MixPlan {
+  uint16_t revision;  // storageRevision the plan was compiled from
+  uint8_t count;
+  MixPlanItem items[MAX_MIXERS];
+  // channels in the same loop share the same non-zero loop number
+  uint8_t channelLoop[MAX_OUTPUT_CHANNELS];
+};
+
+extern MixPlan mixPlan;
+
+// Runtime state of the mix lines which have a delay or a slow, one slot per
+// line in the mix plan order, so that the mixer loop reads it sequentially.
+// The state follows its line when the plan is compiled again.
+struct MixRuntime {
+  uint8_t count;
+  uint8_t lines[MAX_MIXERS];   // mix line index of each slot
+  int32_t act[MAX_MIXERS];     // slow: current value << 8
+  uint16_t delay[MAX_MIXERS];  // delay: remaining time (10ms)
+  int16_t now[MAX_MIXERS];     // delay: condition value
+  int16_t prev[MAX_MIXERS];    // delay: value before the condition changed
+};
+
+extern MixRuntime mixRuntime;
+
+// Reset the delays and slows of all the mix lines
+void mixRuntimeReset();
+
+// Compile the mix plan from the current model
+void mixPlanCompile();
+
+// Compile the mix plan if the model changed since the last compilation
+inline void mixPlanUpdate()
+{
+  if (mixPlan.revision != storageRevision) {
+    mixPlanCompile();
+  }
+}
+
+// Whether the given mix line reads a channel which depends on its own
+// destination channel
+bool isMixInChannelLoop(uint8_t index);
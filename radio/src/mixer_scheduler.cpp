@@ -49,18 +49,58 @@ bool mixerSchedulerWaitForTrigger(uint8_t timeoutMs)
 #endif
 }
 
+uint32_t mixerSchedulesAdvance(MixerSchedule * schedules, uint32_t elapsedUs,
+                               bool heartbeat, uint8_t & due)
+{
+  int32_t next = INT32_MAX;
+
+  for (uint8_t module = 0; module < NUM_MODULES; module++) {
+    auto& schedule = schedules[module];
+    uint16_t period = schedule.period;
+
+    if (!period) {
+      // not scheduled: follows the mixer
+      schedule.remaining = 0;
+      due |= (1 << module);
+      continue;
+    }
+
+    if (heartbeat && module == INTERNAL_MODULE) {
+      schedule.remaining = 0;
+    } else {
+      schedule.remaining -= elapsedUs;
+    }
+
+    if (schedule.remaining <= (int32_t)MIXER_SCHEDULER_MERGE_US) {
+      due |= (1 << module);
+      schedule.remaining += period;
+      if (schedule.remaining <= (int32_t)MIXER_SCHEDULER_MERGE_US) {
+        // frames were missed, restart the phase from now
+        schedule.remaining = period;
+      }
+    }
+
+    if (schedule.remaining < next) {
+      next = schedule.remaining;
+    }
+  }
+
+  return next == INT32_MAX ? 0 : next;
+}
+
 #if !defined(SIMU)
 
 // Global trigger flag
 
-// Mixer schedule
-struct MixerSchedule {
+static MixerSchedule mixerSchedules[NUM_MODULES];
+static volatile uint8_t mixerDueModules = 0;
 
-  // period in us
-  volatile uint16_t period;
-};
+static volatile uint16_t mixerTriggerTime = 0;
 
-static MixerSchedule mixerSchedules[NUM_MODULES];
+uint16_t mixerSchedulerGetTriggerTime()
+{
+  return mixerTriggerTime;
+}
 
 uint16_t getMixerSchedulerPeriod()
 {
@@ -96,7 +136,14 @@ void mixerSchedulerSetPeriod(uint8_t moduleIdx, uint16_t periodUs)
     periodUs = MAX_REFRESH_RATE;
   }
 
-  mixerSchedules[moduleIdx].period = periodUs;
+  // the timer ISR updates the schedule as well (mixerSchedulerUpdate())
+  auto& schedule = mixerSchedules[moduleIdx];
+  __disable_irq();
+  schedule.period = periodUs;
+  if (schedule.remaining > periodUs) {
+    schedule.remaining = periodUs;
+  }
+  __enable_irq();
 }
 
 uint16_t mixerSchedulerGetPeriod(uint8_t moduleIdx)
@@ -104,10 +151,34 @@ uint16_t mixerSchedulerGetPeriod(uint8_t moduleIdx)
   return mixerSchedules[moduleIdx].period;
 }
 
+uint16_t mixerSchedulerUpdate(uint32_t elapsedUs, bool heartbeat)
+{
+  uint8_t due = 0;
+  uint32_t next = mixerSchedulesAdvance(mixerSchedules, elapsedUs, heartbeat, due);
+
+  mixerDueModules |= due;
+
+  if (!next) {
+    // no module scheduled
+    return getMixerSchedulerPeriod();
+  }
+
+  return next;
+}
+
+uint8_t mixerSchedulerGetDueModules()
+{
+  uint8_t due = mixerDueModules;
+  mixerDueModules = 0;
+  return due;
+}
+
 void mixerSchedulerISRTrigger()
 {
   BaseType_t xHigherPriorityTaskWoken = pdFALSE;
 
+  mixerTriggerTime = getTmr2MHz();
+
   /* At this point xTaskToNotify should not be NULL as
      a transmission was in progress. */
   configASSERT( mixerTaskId.rtos_handle != NULL );
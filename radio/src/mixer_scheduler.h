@@ -29,6 +29,26 @@
 #define MIN_REFRESH_RATE       850 /* us */
 #define MAX_REFRESH_RATE     50000 /* us */
 
+// module frames closer than this are served by the same mixer run
+#define MIXER_SCHEDULER_MERGE_US  200 /* us */
+
+// Frame schedule of a module
+struct MixerSchedule {
+
+  // period in us (0: not scheduled, the module follows the mixer)
+  volatile uint16_t period;
+
+  // time until the next frame in us
+  int32_t remaining;
+};
+
+// Advance the schedules of the modules by 'elapsedUs' ('heartbeat' when the
+// internal module frame starts now). Each module keeps its own frame phase:
+// the modules whose frame is due are added to 'due' and the delay (us) until
+// the next frame is returned, 0 if no module is scheduled.
+uint32_t mixerSchedulesAdvance(MixerSchedule * schedules, uint32_t elapsedUs,
+                               bool heartbeat, uint8_t & due);
+
 #if !defined(SIMU)
 
 // Call once to initialize the mixer scheduler
@@ -46,6 +66,16 @@ void mixerSchedulerSetPeriod(uint8_t moduleIdx, uint16_t periodUs);
 // Get the scheduling period for a given module
 uint16_t mixerSchedulerGetPeriod(uint8_t moduleIdx);
 
+// Called by the timer ISR on each trigger, with the time elapsed since
+// the previous one ('heartbeat' when the internal module frame starts now).
+// Each module keeps its own frame phase: the modules whose frame is due
+// are flagged and the delay (us) until the next frame is returned.
+uint16_t mixerSchedulerUpdate(uint32_t elapsedUs, bool heartbeat);
+
+// Mask of the modules whose frame was due since the last call
+// (all modules without period are always due)
+uint8_t mixerSchedulerGetDueModules();
+
 // Enable the timer trigger
 void mixerSchedulerEnableTrigger();
 
@@ -61,6 +91,9 @@ uint16_t getMixerSchedulerPeriod();
 // Trigger mixer from an ISR
 void mixerSchedulerISRTrigger();
 
+// getTmr2MHz() value of the last trigger
+uint16_t mixerSchedulerGetTriggerTime();
+
 #else
 
 #define mixerSchedulerInit()
@@ -68,6 +101,7 @@ void mixerSchedulerISRTrigger();
 #define mixerSchedulerStop()
 #define mixerSchedulerSetPeriod(m,p) ((void)(p))
 #define mixerSchedulerGetPeriod(m) ((uint16_t)MIXER_SCHEDULER_DEFAULT_PERIOD_US)
+#define mixerSchedulerGetDueModules() ((uint8_t)0xFF)
 
 #define mixerSchedulerEnableTrigger()
 #define mixerSchedulerDisableTrigger()
@@ -76,6 +110,7 @@ void mixerSchedulerISRTrigger();
 
 #define getMixerSchedulerPeriod() (MIXER_SCHEDULER_DEFAULT_PERIOD_US)
 #define mixerSchedulerISRTrigger()
+#define mixerSchedulerGetTriggerTime() (getTmr2MHz())
 
 #endif
 
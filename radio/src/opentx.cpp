@@ -29,6 +29,7 @@
 #include "switches.h"
 #include "inactivity_timer.h"
 #include "input_mapping.h"
+#include "input_plan.h"
 
 #include "tasks.h"
 #include "tasks/mixer_task.h"
@@ -391,8 +392,21 @@ int8_t getMovedSource(uint8_t min)
   static tmr10ms_t s_move_last_time = 0;
 
   static int16_t inputsStates[MAX_INPUTS];
+  static uint32_t inputsKnown = 0;  // inputs evaluated when their state was saved
+  uint32_t inputsEvaluated = 0;
   if (min <= MIXSRC_FIRST_INPUT) {
+    // the inputs not used by the model are only evaluated once requested
+    inputsEvaluated = inputPlanRequestInputs(((uint64_t)1 << MAX_INPUTS) - 1);
     for (uint8_t i = 0; i < MAX_INPUTS; i++) {
+      uint32_t mask = (uint32_t)1 << i;
+      if (!(inputsEvaluated & mask))
+        continue;
+      if (!(inputsKnown & mask)) {
+        // first value since the input is evaluated
+        inputsStates[i] = anas[i];
+        inputsKnown |= mask;
+        continue;
+      }
       if (abs(anas[i] - inputsStates[i]) > MULTIPOS_STEP_SIZE) {
         if (!isInputRecursive(i)) {
           result = MIXSRC_FIRST_INPUT + i;
@@ -432,6 +446,7 @@ int8_t getMovedSource(uint8_t min)
   if (result || recent) {
     memcpy(inputsStates, anas, sizeof(inputsStates));
     memcpy(sourcesStates, calibratedAnalogs, sizeof(sourcesStates));
+    inputsKnown = inputsEvaluated;
   }
 
   s_move_last_time = get_tmr10ms();
@@ -1007,7 +1022,7 @@ void checkTrims()
         killTrimEvents(event);
       }
 
-      SET_GVAR_VALUE(gvar, phase, after);
+      setGVarValue(gvar, after, phase);
     }
     else
 #endif
@@ -1259,6 +1274,17 @@ void opentxResume()
 
 void instantTrim()
 {
+  // the inputs of the sticks are needed even when the model doesn't use them
+  uint32_t stickInputs = 0;
+  for (uint8_t i = 0; i < MAX_EXPOS; i++) {
+    ExpoData * expo = expoAddress(i);
+    if (!EXPO_VALID(expo))
+      break;
+    if (expo->srcRaw >= MIXSRC_FIRST_STICK && expo->srcRaw <= MIXSRC_LAST_STICK)
+      stickInputs |= (uint32_t)1 << expo->chn;
+  }
+  inputPlanRequestInputs(stickInputs);
+
   int16_t anas_0[MAX_INPUTS];
   evalInputs(e_perout_mode_notrainer | e_perout_mode_nosticks);
   memcpy(anas_0, anas, sizeof(anas_0));
@@ -1319,8 +1345,8 @@ void copySticksToOffset(uint8_t ch)
   zero = (zero*256000 - val*lim) / (1024*256-val);
   ld->offset = (ld->revert ? -zero : zero);
 
-  mixerTaskStart();
   storageDirty(EE_MODEL);
+  mixerTaskStart();
 }
 
 void copyTrimsToOffset(uint8_t ch)
@@ -1341,8 +1367,8 @@ void copyTrimsToOffset(uint8_t ch)
   v += (output * 125) / 128;
   g_model.limitData[ch].offset = limit((int16_t)-1000, (int16_t)v, (int16_t)1000); // make sure the offset doesn't go haywire
 
-  mixerTaskStart();
   storageDirty(EE_MODEL);
+  mixerTaskStart();
 }
 
 void copyMinMaxToOutputs(uint8_t ch)
@@ -1361,8 +1387,8 @@ void copyMinMaxToOutputs(uint8_t ch)
     ld->ppmCenter = center;
   }
 
-  mixerTaskStart();
   storageDirty(EE_MODEL);
+  mixerTaskStart();
 }
 
 #if defined(STARTUP_ANIMATION)
@@ -1439,9 +1465,9 @@ void moveTrimsToOffsets() // copy state of 3 primary to subtrim
     }
   }
 
+  storageDirty(EE_MODEL);
   mixerTaskStart();
 
-  storageDirty(EE_MODEL);
   AUDIO_WARNING2();
 }
 
@@ -1647,6 +1673,7 @@ int main()
 #endif
 
   boardInit();
+  sourceRangesInit();
 
   modulePortInit();
   pulsesInit();
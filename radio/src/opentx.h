@@ -300,10 +300,25 @@ void memswap(void * a, void * b, uint8_t size);
 #define MASK_CFN_TYPE  uint64_t  // current max = 64 customizable switches
 #define MASK_FUNC_TYPE uint32_t  // current max = 32 functions
 
+#define CFN_INDEX_EDGE  0x80  // only acts when its switch becomes active
+
+// Configured functions of a list, built once per storage revision so that the
+// empty slots are not visited and each trigger switch is only read once
+struct CustomFunctionsIndex {
+  uint16_t revision;                                // storageRevision the index was built from
+  uint8_t  count;
+  uint8_t  switchesCount;
+  uint8_t  functions[MAX_SPECIAL_FUNCTIONS];        // configured functions, in list order
+  uint8_t  functionsSwitch[MAX_SPECIAL_FUNCTIONS];  // index in switches[] | CFN_INDEX_EDGE
+  swsrc_t  switches[MAX_SPECIAL_FUNCTIONS];         // distinct trigger switches
+  uint8_t  switchesFlags[MAX_SPECIAL_FUNCTIONS];    // getSwitch() flags
+};
+
 struct CustomFunctionsContext {
   MASK_FUNC_TYPE activeFunctions;
   MASK_CFN_TYPE  activeSwitches;
   tmr10ms_t lastFunctionTime[MAX_SPECIAL_FUNCTIONS];
+  CustomFunctionsIndex index;
 
   inline bool isFunctionActive(uint8_t func)
   {
@@ -447,7 +462,10 @@ extern uint8_t currentBacklightBright;
 void perMain();
 void per10ms();
 
+void sourceRangesInit();
 getvalue_t getValue(mixsrc_t i, bool* valid = nullptr);
+// fetch the values of several sources in one pass (invalid sources read as 0)
+void getValues(const mixsrc_t* sources, getvalue_t* values, uint8_t count);
 
 int8_t getMovedSource(uint8_t min);
 #define GET_MOVED_SOURCE(min, max) getMovedSource(min)
@@ -640,10 +658,7 @@ void copySticksToOffset(uint8_t ch);
 void copyMinMaxToOutputs(uint8_t ch);
 void moveTrimsToOffsets();
 
-inline bool isExpoActive(uint8_t expo)
-{
-  return swOn[expo].activeExpo;
-}
+bool isExpoActive(uint8_t expo);
 
 inline bool isMixActive(uint8_t mix)
 {
@@ -46,8 +46,6 @@
 
 #define MAX_NO_OF_MODELS            20
 
-//get channel value outside of afhds3 namespace
-int32_t getChannelValue(uint8_t channel);
 void processFlySkyAFHDS3Sensor(const uint8_t * packet, uint8_t type);
 void processFlySkySensor(const uint8_t * packet, uint8_t type);
 
@@ -938,7 +936,7 @@ void ProtoState::sendChannelsData()
 
   for (uint8_t channel = channels_start, index = 1; channel < channels_last;
        channel++, index++) {
-    int16_t channelValue = convert(::getChannelValue(channel));
+    int16_t channelValue = convert(::getModuleChannelValue(module_index, channel));
     buffer[index] = channelValue;
   }
 
@@ -109,7 +109,7 @@ static void crossfireSetupMixerScheduler(uint8_t module)
   }
 }
 
-static bool _checkFrameCRC(uint8_t* rxBuffer)
+static bool _checkFrameCRC(const uint8_t* rxBuffer)
 {
   uint8_t len = rxBuffer[1];
   uint8_t crc = crc8(&rxBuffer[2], len-1);
@@ -169,6 +169,8 @@ static void _seekStart(uint8_t* buffer, uint8_t* len)
   *len = 0;
 }
 
+static void _processFrames(void* ctx, uint8_t* buffer, uint8_t* len);
+
 static void crossfireProcessData(void* ctx, uint8_t data, uint8_t* buffer, uint8_t* len)
 {
   if (*len == 0 && data != RADIO_ADDRESS && data != UART_SYNC) {
@@ -190,17 +192,28 @@ static void crossfireProcessData(void* ctx, uint8_t data, uint8_t* buffer, uint8
     *len = 0;
   }
 
+  _processFrames(ctx, buffer, len);
+}
+
+// frame with a valid CRC
+static void _processFrame(void* ctx, const uint8_t* frame, uint8_t len, uint16_t time)
+{
+#if defined(BLUETOOTH) // TODO: generic telemetry mirror to BT
+  if (g_eeGeneral.bluetoothMode == BLUETOOTH_TELEMETRY &&
+      bluetooth.state == BLUETOOTH_STATE_CONNECTED) {
+    bluetooth.write(frame, len);
+  }
+#endif
+  auto mod_st = (etx_module_state_t*)ctx;
+  processCrossfireTelemetryFrame(modulePortGetModule(mod_st), frame, len, time);
+}
+
+static void _processFrames(void* ctx, uint8_t* buffer, uint8_t* len)
+{
   // rxBuffer[1] holds the packet length-2, check if the whole packet was received
   while (*len > 4 && (buffer[1]+2) == *len) {
     if (_checkFrameCRC(buffer)) {
-#if defined(BLUETOOTH) // TODO: generic telemetry mirror to BT
-      if (g_eeGeneral.bluetoothMode == BLUETOOTH_TELEMETRY &&
-          bluetooth.state == BLUETOOTH_STATE_CONNECTED) {
-        bluetooth.write(buffer, *len);
-      }
-#endif
-      auto mod_st = (etx_module_state_t*)ctx;
-      processCrossfireTelemetryFrame(modulePortGetModule(mod_st));
+      _processFrame(ctx, buffer, *len, getTmr2MHz());
       *len = 0;
     }
     else {
@@ -210,6 +223,59 @@ static void crossfireProcessData(void* ctx, uint8_t data, uint8_t* buffer, uint8
   }
 }
 
+static void crossfireProcessBuffer(void* ctx, const uint8_t* data, uint32_t size,
+                                   uint8_t* buffer, uint8_t* len)
+{
+  while (size > 0) {
+    // once the length of the frame is known (and sane), the rest
+    // of the frame is copied at once
+    uint8_t frameLen = buffer[1] + 2;
+    if (*len >= 2 && *len < frameLen) {
+      uint32_t count = min<uint32_t>(size, frameLen - *len);
+      memcpy(buffer + *len, data, count);
+      *len += count;
+      data += count;
+      size -= count;
+      _processFrames(ctx, buffer, len);
+    } else {
+      crossfireProcessData(ctx, *data++, buffer, len);
+      size--;
+    }
+  }
+}
+
+static void crossfireProcessFrame(void* ctx, const etx_serial_frame_t* frame,
+                                  uint8_t* buffer, uint8_t* len)
+{
+  for (uint8_t i = 0; i < 2; i++) {
+    const uint8_t* data = frame->data[i];
+    uint32_t size = frame->len[i];
+
+    while (size > 0) {
+      // complete frames are checked and processed in place
+      if (*len == 0 && size > 1 &&
+          (data[0] == RADIO_ADDRESS || data[0] == UART_SYNC) &&
+          _lenIsSane(data[1]) && uint32_t(data[1] + 2) <= size &&
+          _checkFrameCRC(data)) {
+        uint8_t frameLen = data[1] + 2;
+        _processFrame(ctx, data, frameLen, frame->time);
+        data += frameLen;
+        size -= frameLen;
+        continue;
+      }
+
+      // otherwise (frame split around the end of the driver buffer or
+      // across idle lines, garbage) until the next frame start
+      uint32_t count = 1;
+      if (*len >= 2 && *len < buffer[1] + 2)
+        count = min<uint32_t>(size, buffer[1] + 2 - *len);
+      crossfireProcessBuffer(ctx, data, count, buffer, len);
+      data += count;
+      size -= count;
+    }
+  }
+}
+
 static const etx_serial_init crsfSerialParams = {
   .baudrate = 0,
   .encoding = ETX_Encoding_8N1,
@@ -240,6 +306,13 @@ static void* crossfireInit(uint8_t module)
 
   if (mod_st) {
     mixerSchedulerSetPeriod(module, CROSSFIRE_PERIOD(module));
+
+    // receive telemetry frames delimited by the idle line when possible
+    auto drv = modulePortGetSerialDrv(mod_st->rx);
+    auto drv_ctx = modulePortGetCtx(mod_st->rx);
+    if (drv && drv_ctx && drv->setFrameMode) {
+      drv->setFrameMode(drv_ctx, true);
+    }
   }
 
   return (void*)mod_st;
@@ -257,4 +330,6 @@ const etx_proto_driver_t CrossfireDriver = {
   .deinit = crossfireDeInit,
   .sendPulses = crossfireSendPulses,
   .processData = crossfireProcessData,
+  .processBuffer = crossfireProcessBuffer,
+  .processFrame = crossfireProcessFrame,
 };
@@ -70,7 +70,7 @@ static void setupPulsesDSM2(uint8_t module, uint8_t*& p_buf)
 
   for (int i=0; i<DSM2_CHANS; i++) {
     int channel = g_model.moduleData[module].channelsStart+i;
-    int value = channelOutputs[channel] + 2*PPM_CH_CENTER(channel) - 2*PPM_CENTER;
+    int value = getModuleChannelValue(module, channel);
     uint16_t pulse = limit(0, ((value*13)>>5)+512, 1023);
     dsmDat[2+2*i] = (i<<2) | ((pulse>>8)&0x03);
     dsmDat[3+2*i] = pulse & 0xff;
@@ -135,7 +135,7 @@ static void setupPulsesLemonDSMP(uint8_t module, uint8_t*& p_buf)
       if (current_channel < channels) {
         
         uint8_t channel = start_channel + current_channel;
-        int value = channelOutputs[channel] + 2*PPM_CH_CENTER(channel) - 2*PPM_CENTER;
+        int value = getModuleChannelValue(module, channel);
         uint16_t pulse;
 
         // Use 11-bit ?
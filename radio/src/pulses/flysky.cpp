@@ -294,8 +294,7 @@ inline void putFlySkySendChannelData(uint8_t*& p_buf)
     putFlySkyFrameByte(p_buf, FLYSKY_CHANNEL_DATA_NORMAL);
     putFlySkyFrameByte(p_buf, channels_last - channels_start);
     for (uint8_t channel = channels_start; channel < channels_last; channel++) {
-      int channelValue =
-          channelOutputs[channel] + 2 * PPM_CH_CENTER(channel) - 2 * PPM_CENTER;
+      int channelValue = getModuleChannelValue(INTERNAL_MODULE, channel);
       pulseValue = limit<uint16_t>(0, 988 + ((channelValue + 1024) / 2), 0xfff);
       putFlySkyFrameByte(p_buf, pulseValue & 0xff);
       putFlySkyFrameByte(p_buf, pulseValue >> 8);
@@ -303,7 +303,7 @@ static void sendChannels(uint8_t*& p_buf, uint8_t module)
   // Multi uses [204;1843] as [-100%;100%]
   for (int i = 0; i < MULTI_CHANS; i++) {
     int channel = g_model.moduleData[module].channelsStart + i;
-    int value = channelOutputs[channel] + 2 * PPM_CH_CENTER(channel) - 2 * PPM_CENTER;
+    int value = getModuleChannelValue(module, channel);
 
     // Scale to 80%
     value = value * 800 / 1000 + 1024;
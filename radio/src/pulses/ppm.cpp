@@ -33,7 +33,8 @@
 #define PPM_SAFE_MARGIN 3000 // 3ms
 
 template <class T>
-uint16_t setupPulsesPPM(T*& data, uint8_t channelsStart, int8_t channelsCount)
+uint16_t setupPulsesPPM(T*& data, const int16_t* outputs, uint8_t channelsStart,
+                        int8_t channelsCount)
 {
   uint16_t total = 0;
   int16_t PPM_range = g_model.extendedLimits ?
@@ -49,7 +50,7 @@ uint16_t setupPulsesPPM(T*& data, uint8_t channelsStart, int8_t channelsCount)
 
   for (uint32_t i = firstCh; i < lastCh; i++) {
     int16_t v =
-        limit((int16_t)-PPM_range, channelOutputs[i], (int16_t)PPM_range) +
+        limit((int16_t)-PPM_range, outputs[i], (int16_t)PPM_range) +
         2 * PPM_CH_CENTER(i);
     *data++ = v;
     total += v;
@@ -62,7 +63,7 @@ void setupPulsesPPMTrainer()
 {
   auto p_data = trainerPulsesData.ppm.pulses;
   uint16_t total = setupPulsesPPM<trainer_pulse_duration_t>(
-      p_data, g_model.trainerData.channelsStart,
+      p_data, channelOutputs, g_model.trainerData.channelsStart,
       g_model.trainerData.channelsCount);
 
   uint32_t rest = PPM_TRAINER_PERIOD_HALF_US();
@@ -87,7 +88,7 @@ void setupPulsesPPMTrainer()
 static uint32_t setupPulsesPPMModule(uint8_t module, pulse_duration_t*& data)
 {
   auto start = data;
-  setupPulsesPPM(data,
+  setupPulsesPPM(data, pulsesGetModuleOutputs(module),
                  g_model.moduleData[module].channelsStart,
                  g_model.moduleData[module].channelsCount);
 
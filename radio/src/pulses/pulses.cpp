@@ -27,6 +27,7 @@
 #include "hal/module_port.h"
 #include "tasks/mixer_task.h"
 
+#include "pulses/rf_latency.h"
 #include "pulses/pxx2.h"
 #include "pulses/flysky.h"
 #include "pulses/dsm2.h"
@@ -531,6 +532,23 @@ static bool _handle_async_restart(uint8_t module)
   return false;
 }
 
+// Double buffered channel outputs of each module: the mixer fills the
+// back buffer when the module frame is due, then makes it the front one
+static int16_t _module_outputs[MAX_MODULES][2][MAX_OUTPUT_CHANNELS];
+static volatile uint8_t _module_outputs_front[MAX_MODULES];
+
+int16_t* pulsesGetModuleOutputs(uint8_t module)
+{
+  return _module_outputs[module][_module_outputs_front[module]];
+}
+
+static void _snapshot_module_outputs(uint8_t module)
+{
+  uint8_t back = _module_outputs_front[module] ^ 1;
+  memcpy(_module_outputs[module][back], channelOutputs, sizeof(channelOutputs));
+  _module_outputs_front[module] = back;
+}
+
 void pulsesSendNextFrame(uint8_t module)
 {
   if (module >= MAX_MODULES) return;
@@ -558,20 +576,24 @@ void pulsesSendNextFrame(uint8_t module)
   auto mod = &(_module_drivers[module]);
   if (mod->drv) {
     uint8_t channelStart = g_model.moduleData[module].channelsStart;
-    int16_t* channels = &channelOutputs[channelStart];
+    int16_t* channels = &pulsesGetModuleOutputs(module)[channelStart];
     uint8_t nChannels = 16; // TODO: MAX_CHANNELS - channelsStart
 
     auto drv = mod->drv;
     auto ctx = mod->ctx;
     auto buffer = _module_buffers[module]._buffer;
     drv->sendPulses(ctx, buffer, channels, nChannels);
+    rfLatencyAddFrame(module, protocol);
   }
 }
 
-void pulsesSendChannels()
+void pulsesSendChannels(uint8_t modules)
 {
   for (uint8_t i = 0; i < MAX_MODULES; i++) {
-    pulsesSendNextFrame(i);
+    if (modules & (1 << i)) {
+      _snapshot_module_outputs(i);
+      pulsesSendNextFrame(i);
+    }
   }
 }
 
@@ -592,7 +614,8 @@ void setCustomFailsafe(uint8_t moduleIndex)
   }
 }
 
-int32_t getChannelValue(uint8_t channel)
+int32_t getModuleChannelValue(uint8_t module, uint8_t channel)
 {
-  return channelOutputs[channel] + 2 * PPM_CH_CENTER(channel) - 2 * PPM_CENTER;
+  return pulsesGetModuleOutputs(module)[channel] + 2 * PPM_CH_CENTER(channel) -
+         2 * PPM_CENTER;
 }
@@ -163,7 +163,17 @@ uint8_t* pulsesGetModuleBuffer(uint8_t module);
 
 void pulsesStopModule(uint8_t module);
 void pulsesSendNextFrame(uint8_t module);
-void pulsesSendChannels();
+
+// send the next frame of the modules in the mask
+// (see mixerSchedulerGetDueModules())
+void pulsesSendChannels(uint8_t modules);
+
+// channel outputs as seen by the module (indexed like channelOutputs),
+// taken when its last frame was due
+int16_t* pulsesGetModuleOutputs(uint8_t module);
+
+// channel value sent to the module, PPM center included
+int32_t getModuleChannelValue(uint8_t module, uint8_t channel);
 
 typedef void (*module_init_cb_t)(uint8_t, const etx_proto_driver_t*);
 typedef void (*module_deinit_cb_t)(uint8_t, const etx_proto_driver_t*);
@@ -130,12 +130,12 @@ void Pxx1Pulses<PxxTransport>::addChannels(uint8_t moduleIdx, uint8_t sendFailsa
     else {
       if (i < sendUpperChannels) {
         int channel = 8 + g_model.moduleData[moduleIdx].channelsStart + i;
-        int value = channelOutputs[channel] + 2*PPM_CH_CENTER(channel) - 2*PPM_CENTER;
+        int value = getModuleChannelValue(moduleIdx, channel);
         pulseValue = limit(2049, (value * 512 / 682) + 3072, 4094);
       }
       else if (i < sentModulePXXChannels(moduleIdx)) {
         int channel = g_model.moduleData[moduleIdx].channelsStart + i;
-        int value = channelOutputs[channel] + 2*PPM_CH_CENTER(channel) - 2*PPM_CENTER;
+        int value = getModuleChannelValue(moduleIdx, channel);
         pulseValue = limit(1, (value * 512 / 682) + 1024, 2046);
       }
       else {
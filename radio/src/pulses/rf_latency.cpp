@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "opentx.h"
+#include "rf_latency.h"
+#include "hal/module_driver.h"
+
+const char * const rfLatencyStageNames[RF_LATENCY_COUNT] = {
+  "mixer",
+  "module",
+  "total",
+};
+
+static const char * const rfLatencyProtocolNames[] = {
+  "---",
+  "none",
+  "PPM",
+  "PPM MLink",
+  "PXX1",
+  "DSM2 LP45",
+  "DSM2",
+  "DSMX",
+  "CRSF",
+  "MULTI",
+  "SBUS",
+  "PXX2",
+  "AFHDS2A",
+  "AFHDS3",
+  "Ghost",
+  "DSMP",
+};
+
+static_assert(DIM(rfLatencyProtocolNames) == PROTOCOL_CHANNELS_DSMP + 1,
+              "rfLatencyProtocolNames must match the module protocols");
+
+struct RfLatency {
+  uint8_t protocol;
+  LatencyHistogram histograms[RF_LATENCY_COUNT];
+};
+
+static RfLatency rfLatencies[MAX_MODULES];
+static volatile uint8_t rfLatencyResetRequest = 0;
+static FIL rfLatencyFile __DMA;
+
+void rfLatencyAddFrame(uint8_t module, uint8_t protocol)
+{
+  RfLatency & latency = rfLatencies[module];
+
+  if (latency.protocol != protocol || (rfLatencyResetRequest & (1 << module))) {
+    for (auto & histogram : latency.histograms) {
+      histogram.reset();
+    }
+    latency.protocol = protocol;
+    rfLatencyResetRequest &= ~(1 << module);
+  }
+
+  uint16_t now = getTmr2MHz();
+  latency.histograms[RF_LATENCY_MIXER].add(channelOutputsTime - channelOutputsSampleTime);
+  latency.histograms[RF_LATENCY_MODULE].add(now - channelOutputsTime);
+  latency.histograms[RF_LATENCY_TOTAL].add(now - channelOutputsSampleTime);
+}
+
+const LatencyHistogram & rfLatencyGet(uint8_t module, uint8_t stage)
+{
+  return rfLatencies[module].histograms[stage];
+}
+
+uint8_t rfLatencyGetProtocol(uint8_t module)
+{
+  return rfLatencies[module].protocol;
+}
+
+const char * rfLatencyGetProtocolName(uint8_t protocol)
+{
+  if (protocol >= DIM(rfLatencyProtocolNames))
+    return rfLatencyProtocolNames[0];
+  return rfLatencyProtocolNames[protocol];
+}
+
+void rfLatencyReset()
+{
+  rfLatencyResetRequest = (1 << MAX_MODULES) - 1;
+}
+
+const char * rfLatencySave()
+{
+  if (!sdMounted())
+    return STR_NO_SDCARD;
+
+  // /LOGS/rflatency-YYYY-MM-DD-HHMMSS.csv
+  char filename[sizeof(LOGS_PATH) + 10 + 18 + 4 + 1];
+  strcpy(filename, STR_LOGS_PATH);
+  const char * error = sdCheckAndCreateDirectory(filename);
+  if (error) {
+    return error;
+  }
+
+  char * tmp = strAppend(&filename[sizeof(LOGS_PATH) - 1], "/rflatency");
+#if defined(RTCLOCK)
+  tmp = strAppendDate(tmp, true);
+#endif
+  strcpy(tmp, ".csv");
+
+  FIL & file = rfLatencyFile;
+  FRESULT result = f_open(&file, filename, FA_CREATE_ALWAYS | FA_WRITE);
+  if (result != FR_OK) {
+    return SDCARD_ERROR(result);
+  }
+
+  f_puts("Module,Protocol,Stage,Count,p50(us),p99(us),p999(us),Max(us)", &file);
+  for (uint8_t i = 0; i < LATENCY_HISTOGRAM_BUCKETS; i++) {
+    uint16_t bound = LatencyHistogram::bucketMax(i);
+    f_printf(&file, ",<=%u.%uus", bound / 2, (bound & 1) * 5);
+  }
+  f_puts("\n", &file);
+
+  for (uint8_t module = 0; module < MAX_MODULES; module++) {
+    const RfLatency & latency = rfLatencies[module];
+    for (uint8_t stage = 0; stage < RF_LATENCY_COUNT; stage++) {
+      const LatencyHistogram & histogram = latency.histograms[stage];
+      if (!histogram.getCount())
+        continue;
+      f_printf(&file, "%s,%s,%s,%u,%u,%u,%u,%u",
+               module == INTERNAL_MODULE ? "internal" : "external",
+               rfLatencyGetProtocolName(latency.protocol),
+               rfLatencyStageNames[stage], (unsigned)histogram.getCount(),
+               histogram.getPercentile(500) / 2,
+               histogram.getPercentile(990) / 2,
+               histogram.getPercentile(999) / 2, histogram.getMax() / 2);
+      for (uint8_t i = 0; i < LATENCY_HISTOGRAM_BUCKETS; i++) {
+        f_printf(&file, ",%u", (unsigned)histogram.getBucket(i));
+      }
+      f_puts("\n", &file);
+    }
+  }
+
+  f_close(&file);
+  return nullptr;
+}
@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include "latency_histogram.h"
+
+// Stick to RF latency tracer
+//
+// The ADC sample time follows the channel outputs computed from it
+// (channelOutputsSampleTime), and the latency is measured when a frame
+// built from these outputs is handed over to the module driver. The
+// histograms of each module are reset when its protocol changes.
+
+enum RfLatencyStage {
+  RF_LATENCY_MIXER,   // ADC sample to channel outputs
+  RF_LATENCY_MODULE,  // channel outputs to module frame
+  RF_LATENCY_TOTAL,   // ADC sample to module frame
+  RF_LATENCY_COUNT
+};
+
+extern const char * const rfLatencyStageNames[RF_LATENCY_COUNT];
+
+// called by pulsesSendNextFrame() once the frame is handed over
+void rfLatencyAddFrame(uint8_t module, uint8_t protocol);
+
+const LatencyHistogram & rfLatencyGet(uint8_t module, uint8_t stage);
+uint8_t rfLatencyGetProtocol(uint8_t module);
+const char * rfLatencyGetProtocolName(uint8_t protocol);
+void rfLatencyReset();
+
+// write the histograms to a CSV file in the LOGS directory
+const char * rfLatencySave();
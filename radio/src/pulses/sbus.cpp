@@ -48,7 +48,7 @@ static inline int getChannelValue(uint8_t port, int channel)
   int ch = g_model.moduleData[port].channelsStart + channel;
   // We will ignore 17 and 18th if that brings us over the limit
   if (ch > 31) return 0;
-  return channelOutputs[ch] + 2 * PPM_CH_CENTER(ch) - 2 * PPM_CENTER;
+  return getModuleChannelValue(port, ch);
 }
 
 static void setupPulsesSbus(uint8_t module, uint8_t*& p_buf)
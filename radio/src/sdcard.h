@@ -81,7 +81,8 @@ const char YAMLFILE_CHECKSUM_TAG_NAME[] = "checksum";
 #endif
 
 #define MODELS_EXT          ".bin"
-#define LOGS_EXT            ".csv"
+#define LOGS_EXT            ".etl"
+#define CSV_EXT             ".csv"
 #define SOUNDS_EXT          ".wav"
 #define BMP_EXT             ".bmp"
 #define PNG_EXT             ".png"
@@ -118,7 +119,32 @@ const char YAMLFILE_CHECKSUM_TAG_NAME[] = "checksum";
   filename[sizeof(path)+sizeof(var)] = '\0'; \
   strcat(&filename[sizeof(path)], ext)
 
-extern uint8_t logDelay100ms;
+// Logs SF period parameter: 1..255 in 100ms, or one of the fast periods
+// above LOGS_PERIOD_FAST_PARAM in 10ms (10ms..90ms).
+// The fast periods are a model format change: older firmware truncates
+// 256..264 to 0..8 (logs off, or every 100ms) and older Companion shows
+// them as 25.6s..26.4s.
+#define LOGS_PERIOD_FAST_PARAM  255
+#define LOGS_PERIOD_FAST_COUNT  9
+
+inline uint16_t logsPeriod10ms(int16_t param)
+{
+  return param > LOGS_PERIOD_FAST_PARAM ? param - LOGS_PERIOD_FAST_PARAM : param * 10;
+}
+
+// Position of a period parameter in the editors (<= 0 for the fast periods),
+// so that the periods are sorted
+inline int16_t logsPeriodIndex(int16_t param)
+{
+  return param > LOGS_PERIOD_FAST_PARAM ? param - LOGS_PERIOD_FAST_PARAM - LOGS_PERIOD_FAST_COUNT : param;
+}
+
+inline int16_t logsPeriodParam(int16_t index)
+{
+  return index <= 0 ? index + LOGS_PERIOD_FAST_PARAM + LOGS_PERIOD_FAST_COUNT : index;
+}
+
+extern uint16_t logDelay10ms;
 void logsInit();
 void logsClose();
 void logsWrite();
@@ -34,6 +34,11 @@
 
 extern uint8_t   storageDirtyMsk;
 extern tmr10ms_t storageDirtyTime10ms;
+
+// Incremented each time the radio settings or the current model are marked
+// dirty or (re)loaded. Runtime caches derived from g_model / g_eeGeneral
+// compare it with the revision they were built from to know when to rebuild.
+extern uint16_t  storageRevision;
 #define TIME_TO_WRITE()                (storageDirtyMsk && (tmr10ms_t)(get_tmr10ms() - storageDirtyTime10ms) >= (tmr10ms_t)WRITE_DELAY_10MS)
 
 #if defined(RTC_BACKUP_RAM)
@@ -55,6 +60,9 @@ void storageCheck(bool immediately);
 // Generic storage functions (implemented in storage_common.cpp)
 //
 void storageDirty(uint8_t msk);
+// same as storageDirty() for the values changed at runtime (GVars) which
+// do not change the model structure: storageRevision is left unchanged
+void storageDirtyValues(uint8_t msk);
 void storageFlushCurrentModel();
 void postRadioSettingsLoad();
 void preModelLoad();
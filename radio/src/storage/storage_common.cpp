@@ -22,6 +22,7 @@
 #include "opentx.h"
 #include "timers_driver.h"
 #include "tasks/mixer_task.h"
+#include "input_plan.h"
 
 #if defined(USBJ_EX)
 #include "usb_joystick.h"
@@ -36,13 +37,14 @@
 
 uint8_t   storageDirtyMsk;
 tmr10ms_t storageDirtyTime10ms;
+uint16_t  storageRevision = 1;
 
 #if defined(RTC_BACKUP_RAM)
 uint8_t   rambackupDirtyMsk = EE_GENERAL | EE_MODEL;
 tmr10ms_t rambackupDirtyTime10ms;
 #endif
 
-void storageDirty(uint8_t msk)
+void storageDirtyValues(uint8_t msk)
 {
   storageDirtyMsk |= msk;
   storageDirtyTime10ms = get_tmr10ms();
@@ -53,6 +55,15 @@ void storageDirty(uint8_t msk)
 #endif
 }
 
+void storageDirty(uint8_t msk)
+{
+  if (msk & (EE_GENERAL | EE_MODEL)) {
+    storageRevision++;
+  }
+
+  storageDirtyValues(msk);
+}
+
 void preModelLoad()
 {
   watchdogSuspend(500/*5s*/);
@@ -139,6 +150,9 @@ static void sortMixerLines()
 
 void postModelLoad(bool alarms)
 {
+  storageRevision++;
+  inputPlanReset();
+
 #if defined(COLORLCD)
   // Load 'date time' widget if slot is empty
   if (g_model.topbarData.zones[MAX_TOPBAR_ZONES-1].widgetName[0] == 0) {
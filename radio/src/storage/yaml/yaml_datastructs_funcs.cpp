@@ -1477,7 +1477,7 @@ static void r_customFn(void* user, uint8_t* data, uint32_t bitoffs,
   case FUNC_SET_SCREEN:
 #endif  
   case FUNC_HAPTIC:
-  case FUNC_LOGS: // 10th of seconds
+  case FUNC_LOGS: // 10th of seconds, 256..264: 10..90ms (see sdcard.h)
     CFN_PARAM(cfn) = yaml_str2uint(val, l_sep);
     break;
 
@@ -1659,7 +1659,7 @@ static bool w_customFn(void* user, uint8_t* data, uint32_t bitoffs,
   case FUNC_SET_SCREEN:
 #endif
   case FUNC_HAPTIC:
-  case FUNC_LOGS: // 10th of seconds
+  case FUNC_LOGS: // 10th of seconds, 256..264: 10..90ms (see sdcard.h)
     str = yaml_unsigned2str(CFN_PARAM(cfn));
     if (!wf(opaque, str, strlen(str))) return false;
     break;
@@ -635,14 +635,101 @@ uint8_t getXPotPosition(uint8_t idx)
 }
 
 
+// Logical switches dependency graph
+//
+// A logical switch which only depends on the state of other logical switches
+// (AND / OR / XOR chains, AND switch) does not need to be evaluated again as
+// long as none of these states changed. All the others (sources, physical
+// switches, telemetry, timers, delay / duration...) are "volatile" and are
+// evaluated every cycle.
+//
+// Switches are still evaluated in index order: a switch depending on another
+// one with a higher index sees its state of the previous cycle, as before.
+
+#define LSW_BIT(idx) ((uint64_t)1 << (idx))
+
+static_assert(MAX_LOGICAL_SWITCHES <= 64, "MAX_LOGICAL_SWITCHES too big for uint64_t masks");
+
+struct LogicalSwitchesGraph {
+  bool valid;
+  uint16_t revision;                            // storageRevision the graph was built from
+  uint64_t volatileMask;                        // switches evaluated every cycle
+  uint64_t dependents[MAX_LOGICAL_SWITCHES];    // switches reading the state of each switch
+};
+
+static LogicalSwitchesGraph lswGraph;
+static uint64_t lswDirty[MAX_FLIGHT_MODES];     // switches to be evaluated at next cycle
+
+// returns false if the switch state cannot be tracked through the graph
+static bool addLogicalSwitchDependency(uint8_t idx, swsrc_t swtch)
+{
+  swtch = abs(swtch);
+  if (swtch == SWSRC_NONE || swtch == SWSRC_ON) {
+    return true;
+  }
+  else if (swtch >= SWSRC_FIRST_LOGICAL_SWITCH && swtch <= SWSRC_LAST_LOGICAL_SWITCH) {
+    lswGraph.dependents[swtch - SWSRC_FIRST_LOGICAL_SWITCH] |= LSW_BIT(idx);
+    return true;
+  }
+  else {
+    return false;
+  }
+}
+
+static void buildLogicalSwitchesGraph()
+{
+  memclear(&lswGraph, sizeof(lswGraph));
+
+  for (uint8_t idx = 0; idx < MAX_LOGICAL_SWITCHES; idx++) {
+    LogicalSwitchData * ls = lswAddress(idx);
+    bool tracked;
+    if (ls->func == LS_FUNC_NONE) {
+      tracked = true;
+    }
+    else if (lswFamily(ls->func) == LS_FAMILY_BOOL && !ls->delay && !ls->duration) {
+      tracked = addLogicalSwitchDependency(idx, ls->andsw);
+      tracked = addLogicalSwitchDependency(idx, ls->v1) && tracked;
+      tracked = addLogicalSwitchDependency(idx, ls->v2) && tracked;
+    }
+    else {
+      tracked = false;
+    }
+    if (!tracked) {
+      lswGraph.volatileMask |= LSW_BIT(idx);
+    }
+  }
+
+  for (uint8_t fm = 0; fm < MAX_FLIGHT_MODES; fm++) {
+    lswDirty[fm] = (uint64_t)-1;
+  }
+
+  lswGraph.revision = storageRevision;
+  lswGraph.valid = true;
+}
+
 /**
   @brief Calculates new state of logical switches for mixerCurrentFlightMode
 */
 void evalLogicalSwitches(bool isCurrentFlightmode)
 {
+  if (!lswGraph.valid || lswGraph.revision != storageRevision) {
+    buildLogicalSwitchesGraph();
+  }
+
+  uint64_t & dirty = lswDirty[mixerCurrentFlightMode];
+
   for (unsigned int idx=0; idx<MAX_LOGICAL_SWITCHES; idx++) {
+    if (!((dirty | lswGraph.volatileMask) & LSW_BIT(idx))) {
+      continue;
+    }
+    dirty &= ~LSW_BIT(idx);
+
     LogicalSwitchContext & context = lswFm[mixerCurrentFlightMode].lsw[idx];
     bool result = getLogicalSwitch(idx);
+    if (result != (bool)context.state) {
+      // dependents with a higher index are evaluated in this cycle, the others in the next one
+      dirty |= lswGraph.dependents[idx];
+    }
     if (isCurrentFlightmode) {
       if (result) {
         if (!context.state) PLAY_LOGICAL_SWITCH_ON(idx);
@@ -1043,6 +1130,9 @@ void logicalSwitchesReset()
     }
   }
 
+  // the model may have changed, the graph is rebuilt at next evaluation
+  lswGraph.valid = false;
+
   luaSetStickySwitchBuffer.clear();
 }
 
@@ -1056,4 +1146,5 @@ getvalue_t convertLswTelemValue(LogicalSwitchData * ls)
 void logicalSwitchesCopyState(uint8_t src, uint8_t dst)
 {
   lswFm[dst] = lswFm[src];
+  lswDirty[dst] = (uint64_t)-1;
 }
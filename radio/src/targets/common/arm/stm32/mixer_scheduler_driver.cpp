@@ -60,7 +60,12 @@ void mixerSchedulerDisableTrigger()
   MIXER_SCHEDULER_TIMER->DIER &= ~TIM_DIER_UIE; // disable interrupt
 }
 
+// time elapsed (us) since the last trigger when the heartbeat
+// triggers the mixer before the timer
+static volatile uint16_t _soft_trigger_elapsed = 0;
+
 void mixerSchedulerSoftTrigger() {
+  _soft_trigger_elapsed = MIXER_SCHEDULER_TIMER->CNT + 1;
   // Generate a timer update event (TIM_EGR_UG) to reload the Prescaler and the repetition 
   // counter value immediately to avoid making FreeRTOS calls within this ISR:
   // - fires MIXER_SCHEDULER_TIMER interrupt after returning from this ISR
@@ -74,8 +79,15 @@ extern "C" void MIXER_SCHEDULER_TIMER_IRQHandler(void)
   MIXER_SCHEDULER_TIMER->SR &= ~TIM_SR_UIF; // clear flag
   mixerSchedulerDisableTrigger();
 
-  // set next period
-  MIXER_SCHEDULER_TIMER->ARR = getMixerSchedulerPeriod() - 1;
+  // set next period: the heartbeat gives the internal module frame
+  uint32_t elapsed = MIXER_SCHEDULER_TIMER->ARR + 1;
+  bool heartbeat = false;
+  if (_soft_trigger_elapsed) {
+    elapsed = _soft_trigger_elapsed;
+    heartbeat = true;
+    _soft_trigger_elapsed = 0;
+  }
+  MIXER_SCHEDULER_TIMER->ARR = mixerSchedulerUpdate(elapsed, heartbeat) - 1;
 
   // trigger mixer start
   mixerSchedulerISRTrigger();
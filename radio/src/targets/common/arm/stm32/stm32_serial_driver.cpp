@@ -20,6 +20,7 @@
  */
 
 #include "stm32_serial_driver.h"
+#include "timers_driver.h"
 #include <string.h>
 
 // Serial buffer state
@@ -28,6 +29,16 @@ struct stm32_buffer_state {
   volatile uint32_t widx;
 };
 
+// Frames delimited by the idle line
+#define STM32_SERIAL_RX_FRAMES 8 // power of 2
+
+struct stm32_frame_state {
+  volatile uint32_t end[STM32_SERIAL_RX_FRAMES];   // RX buffer index after the frame
+  volatile uint16_t time[STM32_SERIAL_RX_FRAMES];  // getTmr2MHz() at the idle line
+  volatile uint8_t ridx;
+  volatile uint8_t widx;
+};
+
 struct stm32_send_buffer {
   volatile const uint8_t* buf;
   volatile uint32_t len;
@@ -36,6 +47,7 @@ struct stm32_send_buffer {
 struct stm32_serial_state {
   const stm32_serial_port* sp;
   stm32_buffer_state rx_buf;
+  stm32_frame_state rx_frames;
   union {
     stm32_buffer_state tx_fifo;
     stm32_send_buffer  tx_buf;
@@ -353,6 +365,18 @@ static void stm32_enable_rx(void* ctx)
   stm32_usart_enable_rx(st->sp->usart);
 }
 
+static uint32_t stm32_serial_rx_widx(stm32_serial_state* st)
+{
+  auto usart = st->sp->usart;
+  if (LL_USART_IsEnabledDMAReq_RX(usart->USARTx)) {
+    auto dma = usart->rxDMA;
+    auto stream = usart->rxDMA_Stream;
+    return st->sp->rx_buffer.length - LL_DMA_GetDataLength(dma, stream);
+  } else {
+    return st->rx_buf.widx;
+  }
+}
+
 static int stm32_serial_get_byte(void* ctx, uint8_t* data)
 {
   auto st = (stm32_serial_state*)ctx;
@@ -366,16 +390,7 @@ static int stm32_serial_get_byte(void* ctx, uint8_t* data)
   auto buf = rx_buf.buffer;
   auto& buf_st = st->rx_buf;
 
-  uint32_t widx;
-  auto usart = sp->usart;
-  if (LL_USART_IsEnabledDMAReq_RX(usart->USARTx)) {
-    auto dma = usart->rxDMA;
-    auto stream = usart->rxDMA_Stream;
-    widx = buf_len - LL_DMA_GetDataLength(dma, stream);
-  } else {
-    widx = buf_st.widx;
-  }
-
+  uint32_t widx = stm32_serial_rx_widx(st);
   if (buf_st.ridx == widx)
     return 0;
 
@@ -385,6 +400,36 @@ static int stm32_serial_get_byte(void* ctx, uint8_t* data)
   return 1;
 }
 
+static int stm32_serial_get_bytes(void* ctx, uint8_t* data, uint32_t max_len)
+{
+  auto st = (stm32_serial_state*)ctx;
+  if (!st) return -1;
+
+  auto sp = st->sp;
+  const auto& rx_buf = sp->rx_buffer;
+  auto buf_len = rx_buf.length;
+  if (!buf_len) return -1;
+
+  auto buf = rx_buf.buffer;
+  auto& buf_st = st->rx_buf;
+
+  uint32_t widx = stm32_serial_rx_widx(st);
+  uint32_t ridx = buf_st.ridx;
+  uint32_t count = 0;
+
+  // at most 2 contiguous spans: up to the end of the buffer, then from its start
+  while (ridx != widx && count < max_len) {
+    uint32_t span = (widx > ridx ? widx : buf_len) - ridx;
+    if (span > max_len - count) span = max_len - count;
+    memcpy(data + count, buf + ridx, span);
+    count += span;
+    ridx = (ridx + span) & (buf_len - 1);
+  }
+
+  buf_st.ridx = ridx;
+  return count;
+}
+
 static int stm32_serial_get_last_byte(void* ctx, uint32_t idx, uint8_t* data)
 {
   auto st = (stm32_serial_state*)ctx;
@@ -433,6 +478,9 @@ static void stm32_serial_clear_rx_buffer(void* ctx)
   } else {
     _fifo_clear(buf_st);
   }
+
+  // drop the frames delimited so far
+  st->rx_frames.ridx = st->rx_frames.widx;
 }
 
 static uint32_t stm32_serial_get_baudrate(void* ctx)
@@ -465,6 +513,69 @@ static void stm32_serial_hw_option(void* ctx, uint32_t option)
   stm32_usart_set_hw_option(usart, option);
 }
 
+static void _on_idle_frame()
+{
+  auto st = (stm32_serial_state*)_isr_state;
+  auto& frames = st->rx_frames;
+
+  uint32_t end = stm32_serial_rx_widx(st);
+  uint8_t last = (frames.widx - 1) & (STM32_SERIAL_RX_FRAMES - 1);
+  uint32_t start = (frames.ridx != frames.widx) ? frames.end[last] : st->rx_buf.ridx;
+  if (end == start) return;
+
+  uint8_t next = (frames.widx + 1) & (STM32_SERIAL_RX_FRAMES - 1);
+  if (next == frames.ridx) {
+    // no room left: extend the last frame
+    frames.end[last] = end;
+    frames.time[last] = getTmr2MHz();
+    return;
+  }
+
+  frames.end[frames.widx] = end;
+  frames.time[frames.widx] = getTmr2MHz();
+  frames.widx = next;
+}
+
+static void stm32_serial_set_frame_mode(void* ctx, uint8_t enabled)
+{
+  auto st = (stm32_serial_state*)ctx;
+  if (!st || !st->sp->rx_buffer.length) return;
+
+  st->rx_frames.ridx = st->rx_frames.widx;
+  st->callbacks.on_idle = enabled ? _on_idle_frame : nullptr;
+  stm32_usart_set_idle_irq(st->sp->usart, enabled);
+}
+
+static int stm32_serial_get_frame(void* ctx, etx_serial_frame_t* frame)
+{
+  auto st = (stm32_serial_state*)ctx;
+  if (!st || st->callbacks.on_idle != _on_idle_frame) return -1;
+
+  auto& frames = st->rx_frames;
+  if (frames.ridx == frames.widx) return 0;
+
+  const auto& rx_buf = st->sp->rx_buffer;
+  auto buf_len = rx_buf.length;
+  uint32_t ridx = st->rx_buf.ridx;
+  uint32_t end = frames.end[frames.ridx];
+
+  frame->time = frames.time[frames.ridx];
+  frame->data[0] = rx_buf.buffer + ridx;
+  frame->data[1] = rx_buf.buffer;
+  if (end >= ridx) {
+    frame->len[0] = end - ridx;
+    frame->len[1] = 0;
+  } else {
+    frame->len[0] = buf_len - ridx;
+    frame->len[1] = end;
+  }
+
+  st->rx_buf.ridx = end;
+  frames.ridx = (frames.ridx + 1) & (STM32_SERIAL_RX_FRAMES - 1);
+
+  return frame->len[0] + frame->len[1];
+}
+
 static void stm32_serial_set_idle_cb(void* ctx, void (*on_idle)())
 {
   auto st = (stm32_serial_state*)ctx;
@@ -485,6 +596,9 @@ const etx_serial_driver_t STM32SerialDriver = {
   .waitForTxCompleted = stm32_wait_tx_completed,
   .enableRx = stm32_enable_rx,
   .getByte = stm32_serial_get_byte,
+  .getBytes = stm32_serial_get_bytes,
+  .setFrameMode = stm32_serial_set_frame_mode,
+  .getFrame = stm32_serial_get_frame,
   .getLastByte = stm32_serial_get_last_byte,
   .clearRxBuffer = stm32_serial_clear_rx_buffer,
   .getBaudrate = stm32_serial_get_baudrate,
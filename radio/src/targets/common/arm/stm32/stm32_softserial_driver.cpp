@@ -508,6 +508,9 @@ const etx_serial_driver_t STM32SoftSerialTxDriver = {
   .waitForTxCompleted = stm32_softserial_tx_wait,
   .enableRx = nullptr, // TODO: combine with EXTI / Timer implementation? (S.PORT INV RX)
   .getByte = nullptr,
+  .getBytes = nullptr,
+  .setFrameMode = nullptr,
+  .getFrame = nullptr,
   .clearRxBuffer = nullptr, // TODO: same as enableRx
   .getBaudrate = nullptr,
   .setBaudrate = nullptr,
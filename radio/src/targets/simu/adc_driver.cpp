@@ -27,6 +27,7 @@
 
 #include "hal_adc_inputs.inc"
 #include "board.h"
+#include "input_record.h"
 
 void enableVBatBridge(){}
 void disableVBatBridge(){}
@@ -36,6 +37,11 @@ extern uint16_t simu_get_analog(uint8_t idx);
 
 static bool simu_start_conversion()
 {
+  if (inputReplayActive()) {
+    inputReplayGetAnalogs();
+    return true;
+  }
+
   int max_input = adcGetInputOffset(ADC_INPUT_VBAT);
   for (int i = 0; i < max_input; i++) {
     setAnalogValue(i, simu_get_analog(i));
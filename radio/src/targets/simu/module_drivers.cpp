@@ -76,6 +76,9 @@ const etx_serial_driver_t _fakeSerialDriver = {
     .waitForTxCompleted = waitForTxCompleted,
     .enableRx = nullptr,
     .getByte = getByte,
+    .getBytes = nullptr,
+    .setFrameMode = nullptr,
+    .getFrame = nullptr,
     .getLastByte = nullptr,
     .clearRxBuffer = nullptr,
     .getBaudrate = nullptr,
@@ -23,6 +23,7 @@
 #include "opentx.h"
 #include "simulcd.h"
 #include "switches.h"
+#include "mixer_outputs.h"
 
 #include "hal/adc_driver.h"
 #include "hal/rotary_encoder.h"
@@ -563,27 +564,31 @@ bool OpenTxSimulator::checkLcdChanged()
 void OpenTxSimulator::checkOutputsChanged()
 {
   static TxOutputs lastOutputs;
-  static size_t chansDim = DIM(channelOutputs);
+  static MixerOutputs outputs;
+  static size_t chansDim = DIM(outputs.channels);
   const static int16_t limit = 512 * 2;
   qint32 tmpVal;
   uint8_t i, idx;
   const uint8_t phase = getFlightMode();  // opentx.cpp
 
+  // channels and logical switches from the same mixer cycle
+  mixerOutputsRead(outputs);
+
   for (i=0; i < chansDim; i++) {
-    if (lastOutputs.chans[i] != channelOutputs[i] || m_resetOutputsData) {
-      emit channelOutValueChange(i, channelOutputs[i], (g_model.extendedLimits ? limit * LIMIT_EXT_PERCENT / 100 : limit));
-      emit outputValueChange(OUTPUT_SRC_CHAN_OUT, i, channelOutputs[i]);
-      lastOutputs.chans[i] = channelOutputs[i];
+    if (lastOutputs.chans[i] != outputs.channels[i] || m_resetOutputsData) {
+      emit channelOutValueChange(i, outputs.channels[i], (g_model.extendedLimits ? limit * LIMIT_EXT_PERCENT / 100 : limit));
+      emit outputValueChange(OUTPUT_SRC_CHAN_OUT, i, outputs.channels[i]);
+      lastOutputs.chans[i] = outputs.channels[i];
     }
-    if (lastOutputs.ex_chans[i] != ex_chans[i] || m_resetOutputsData) {
-      emit channelMixValueChange(i, ex_chans[i], limit * 2);
-      emit outputValueChange(OUTPUT_SRC_CHAN_MIX, i, ex_chans[i]);
-      lastOutputs.ex_chans[i] = ex_chans[i];
+    if (lastOutputs.ex_chans[i] != outputs.mixes[i] || m_resetOutputsData) {
+      emit channelMixValueChange(i, outputs.mixes[i], limit * 2);
+      emit outputValueChange(OUTPUT_SRC_CHAN_MIX, i, outputs.mixes[i]);
+      lastOutputs.ex_chans[i] = outputs.mixes[i];
     }
   }
 
   for (i=0; i < MAX_LOGICAL_SWITCHES; i++) {
-    tmpVal = (qint32)GET_SWITCH_BOOL(SWSRC_FIRST_LOGICAL_SWITCH+i);
+    tmpVal = (qint32)((outputs.logicalSwitches >> i) & 1);
     if (lastOutputs.vsw[i] != (bool)tmpVal || m_resetOutputsData) {
       emit virtualSwValueChange(i, tmpVal);
       emit outputValueChange(OUTPUT_SRC_VIRTUAL_SW, i, tmpVal);
@@ -612,6 +612,9 @@ static const etx_serial_driver_t _fake_drv = {
   .waitForTxCompleted = nullptr,
   .enableRx = nullptr,
   .getByte = _fake_drv_get_byte,
+  .getBytes = nullptr,
+  .setFrameMode = nullptr,
+  .getFrame = nullptr,
   .getLastByte = nullptr,
   .clearRxBuffer = nullptr,
   .getBaudrate = nullptr,
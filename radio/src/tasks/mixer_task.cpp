@@ -25,6 +25,7 @@
 
 #include "opentx.h"
 #include "switches.h"
+#include "input_record.h"
 
 #include "watchdog_driver.h"
 
@@ -95,6 +96,81 @@ bool mixerTaskRunning()
   return _mixer_running && !_mixer_exit;
 }
 
+const char * const mixerLatencyNames[MIXER_LATENCY_COUNT] = {
+  "trigger",
+  "getADC",
+  "switches",
+  "evalMixes",
+  "pulses",
+  "cycle",
+  "task",
+};
+
+struct MixerLatencySet {
+  uint16_t period;    // 0 when unused
+  LatencyHistogram histograms[MIXER_LATENCY_COUNT];
+};
+
+static MixerLatencySet mixerLatencySets[MIXER_LATENCY_PERIODS];
+static uint8_t mixerLatencyCurrent = 0;
+static LatencyHistogram * mixerLatencies = mixerLatencySets[0].histograms;
+static volatile bool mixerLatencyReset = false;
+
+static const MixerLatencySet & getLatencySet(uint8_t set)
+{
+  return mixerLatencySets[(mixerLatencyCurrent + set) % MIXER_LATENCY_PERIODS];
+}
+
+const LatencyHistogram & mixerTaskGetLatency(uint8_t index, uint8_t set)
+{
+  return getLatencySet(set).histograms[index];
+}
+
+uint16_t mixerTaskGetLatencyPeriod(uint8_t set)
+{
+  return getLatencySet(set).period;
+}
+
+void mixerTaskResetLatencies()
+{
+  mixerLatencyReset = true;
+}
+
+static void checkLatencyPeriod()
+{
+  if (mixerLatencyReset) {
+    for (auto & set : mixerLatencySets) {
+      set.period = 0;
+      for (auto & histogram : set.histograms) {
+        histogram.reset();
+      }
+    }
+    mixerLatencyReset = false;
+  }
+
+  uint16_t period = getMixerSchedulerPeriod();
+  if (period == mixerLatencySets[mixerLatencyCurrent].period)
+    return;
+
+  // continue the histograms of this period if it was already used,
+  // otherwise reuse the set after the current one
+  uint8_t index = 0;
+  while (index < MIXER_LATENCY_PERIODS && mixerLatencySets[index].period != period) {
+    index++;
+  }
+  if (index == MIXER_LATENCY_PERIODS) {
+    index = (mixerLatencyCurrent + 1) % MIXER_LATENCY_PERIODS;
+    MixerLatencySet & set = mixerLatencySets[index];
+    for (auto & histogram : set.histograms) {
+      histogram.reset();
+    }
+    set.period = period;
+  }
+
+  mixerLatencies = mixerLatencySets[index].histograms;
+  mixerLatencyCurrent = index;
+}
+
 volatile uint16_t timeForcePowerOffPressed = 0;
 
 bool isForcePowerOffRequested()
@@ -152,6 +228,7 @@ TASK_FUNCTION(mixerTask)
   while (!_mixer_exit) {
 
     int timeout = 0;
+    bool triggered = false;
     for (; timeout < MIXER_MAX_PERIOD; timeout += MIXER_FREQUENT_ACTIONS_PERIOD) {
 
       // run periodicals before waiting for the trigger
@@ -160,15 +237,26 @@ TASK_FUNCTION(mixerTask)
 
       // mixer flag triggered?
       if (!mixerSchedulerWaitForTrigger(MIXER_FREQUENT_ACTIONS_PERIOD)) {
+        triggered = true;
         break;
       }
     }
 
+    uint16_t t0 = getTmr2MHz();
+    checkLatencyPeriod();
+    if (triggered) {
+      mixerLatencies[MIXER_LATENCY_TRIGGER].add(t0 - mixerSchedulerGetTriggerTime());
+    }
+
 #if defined(DEBUG_MIXER_SCHEDULER)
     GPIO_SetBits(EXTMODULE_TX_GPIO, EXTMODULE_TX_GPIO_PIN);
     GPIO_ResetBits(EXTMODULE_TX_GPIO, EXTMODULE_TX_GPIO_PIN);
 #endif
 
+    // modules whose frame is due, all of them if the trigger timed out
+    // (fetched while the trigger is still disabled)
+    uint8_t dueModules = triggered ? mixerSchedulerGetDueModules() : 0xFF;
+
     // re-enable trigger
     mixerSchedulerEnableTrigger();
 
@@ -187,13 +275,17 @@ TASK_FUNCTION(mixerTask)
 
     if (_mixer_running) {
 
-      uint16_t t0 = getTmr2MHz();
+      uint16_t t1 = getTmr2MHz();
 
       DEBUG_TIMER_START(debugTimerMixer);
       mixerTaskLock();
 
       doMixerCalculations();
-      pulsesSendChannels();
+
+      uint16_t t2 = getTmr2MHz();
+      pulsesSendChannels(dueModules);
+      mixerLatencies[MIXER_LATENCY_PULSES].add(getTmr2MHz() - t2);
+
       doMixerPeriodicUpdates();
 
       // TODO: what are these for???
@@ -213,9 +305,13 @@ TASK_FUNCTION(mixerTask)
       // so let's do it here.
       WDG_RESET();
 
-      t0 = getTmr2MHz() - t0;
-      if (t0 > maxMixerDuration)
-        maxMixerDuration = t0;
+      uint16_t t3 = getTmr2MHz();
+      mixerLatencies[MIXER_LATENCY_TASK].add(t3 - t0);
+
+      t1 = t3 - t1;
+      mixerLatencies[MIXER_LATENCY_CYCLE].add(t1);
+      if (t1 > maxMixerDuration)
+        maxMixerDuration = t1;
     }
   }
 
@@ -242,15 +338,29 @@ void doMixerCalculations()
   // therefore forget the exact calculation and use only 1 instead; good compromise
   lastTMR = tmr10ms;
 
+  uint16_t t0 = getTmr2MHz();
   DEBUG_TIMER_START(debugTimerGetAdc);
   getADC();
   DEBUG_TIMER_STOP(debugTimerGetAdc);
 
+  uint16_t t1 = getTmr2MHz();
+  mixerLatencies[MIXER_LATENCY_ADC].add(t1 - t0);
+
   DEBUG_TIMER_START(debugTimerGetSwitches);
   getSwitchesPosition(!s_mixer_first_run_done);
   DEBUG_TIMER_STOP(debugTimerGetSwitches);
 
+  mixerLatencies[MIXER_LATENCY_SWITCHES].add(getTmr2MHz() - t1);
+
+#if defined(INPUT_RECORD)
+  inputRecordFrame(tick10ms);
+#endif
+
+  t0 = getTmr2MHz();
   DEBUG_TIMER_START(debugTimerEvalMixes);
+  curvesCacheUpdate();
   evalMixes(tick10ms);
   DEBUG_TIMER_STOP(debugTimerEvalMixes);
+
+  mixerLatencies[MIXER_LATENCY_MIXES].add(getTmr2MHz() - t0);
 }
@@ -19,7 +19,10 @@
  * GNU General Public License for more details.
  */
 
+#pragma once
+
 #include "rtos.h"
+#include "latency_histogram.h"
 
 // needed by the mixer scheduler
 extern RTOS_TASK_HANDLE mixerTaskId;
@@ -78,3 +81,31 @@ void mixerTaskUnlock();
 // returns true if the lock could be acquired
 bool mixerTaskTryLock();
 
+//
+// Latency histograms, always collected by the mixer task
+//
+enum MixerLatency {
+  MIXER_LATENCY_TRIGGER,   // scheduler trigger to task start
+  MIXER_LATENCY_ADC,       // getADC()
+  MIXER_LATENCY_SWITCHES,  // getSwitchesPosition()
+  MIXER_LATENCY_MIXES,     // evalMixes()
+  MIXER_LATENCY_PULSES,    // pulsesSendChannels()
+  MIXER_LATENCY_CYCLE,     // mixer cycle (as maxMixerDuration)
+  MIXER_LATENCY_TASK,      // task start to end of the cycle
+  MIXER_LATENCY_COUNT
+};
+
+extern const char * const mixerLatencyNames[MIXER_LATENCY_COUNT];
+
+// the histograms are kept per mixer period, for the last periods set by
+// the module scheduler; set 0 is the current period
+#define MIXER_LATENCY_PERIODS   2
+
+const LatencyHistogram & mixerTaskGetLatency(uint8_t index, uint8_t set = 0);
+
+// mixer period (us) the histograms of the set were collected with,
+// 0 if the set is unused
+uint16_t mixerTaskGetLatencyPeriod(uint8_t set = 0);
+
+// the histograms are reset by the mixer task on its next cycle
+void mixerTaskResetLatencies();
@@ -100,7 +100,9 @@ enum CrossfireFrames{
   CRSF_FRAME_MODELID_SENT
 };
 
-void processCrossfireTelemetryFrame(uint8_t module);
+// Process a complete frame (CRC checked), received at time (getTmr2MHz())
+void processCrossfireTelemetryFrame(uint8_t module, const uint8_t * frame,
+                                    uint8_t len, uint16_t time);
 void crossfireSetDefault(int index, uint8_t id, uint8_t subId);
 uint8_t createCrossfireModelIDFrame(uint8_t * frame);
 
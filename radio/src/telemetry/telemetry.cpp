@@ -202,6 +202,20 @@ void telemetryMirrorSend(uint8_t data)
   }
 }
 
+void telemetryMirrorSendBuffer(const uint8_t* data, uint32_t size)
+{
+  auto _sendByte = telemetryMirrorSendByte;
+  auto _ctx = telemetryMirrorSendByteCtx;
+
+  // bytes are queued one by one: the port sendBuffer() may send
+  // asynchronously from a buffer which is only temporary here
+  if (_sendByte) {
+    while (size--) {
+      _sendByte(_ctx, *data++);
+    }
+  }
+}
+
 #if !defined(SIMU)
 static TimerHandle_t telemetryTimer = nullptr;
 static StaticTimer_t telemetryTimerBuffer;
@@ -264,12 +278,53 @@ static inline void pollTelemetry(uint8_t module, const etx_proto_driver_t* drv,
   auto serial_drv = modulePortGetSerialDrv(mod_st->rx);
   auto serial_ctx = modulePortGetCtx(mod_st->rx);
 
-  if (!serial_drv  || !serial_ctx || !serial_drv->getByte)
+  if (!serial_drv  || !serial_ctx)
     return;
 
   uint8_t* rxBuffer = getTelemetryRxBuffer(module);
   uint8_t& rxBufferCount = getTelemetryRxBufferCount(module);
 
+  // frames delimited by the driver (when the frame mode could be enabled)
+  etx_serial_frame_t frame;
+  int frameLen;
+  if (serial_drv->getFrame && drv->processFrame &&
+      (frameLen = serial_drv->getFrame(serial_ctx, &frame)) >= 0) {
+    if (frameLen > 0) {
+      LOG_TELEMETRY_WRITE_START();
+      do {
+        for (uint8_t i = 0; i < 2; i++) {
+          telemetryMirrorSendBuffer(frame.data[i], frame.len[i]);
+          LOG_TELEMETRY_WRITE_BUFFER(frame.data[i], frame.len[i]);
+        }
+        drv->processFrame(ctx, &frame, rxBuffer, &rxBufferCount);
+      } while (serial_drv->getFrame(serial_ctx, &frame) > 0);
+    }
+    return;
+  }
+
+  if (serial_drv->getBytes) {
+    uint8_t buffer[TELEMETRY_RX_CHUNK_SIZE];
+    int count = serial_drv->getBytes(serial_ctx, buffer, sizeof(buffer));
+    if (count > 0) {
+      LOG_TELEMETRY_WRITE_START();
+      do {
+        telemetryMirrorSendBuffer(buffer, count);
+        if (drv->processBuffer) {
+          drv->processBuffer(ctx, buffer, count, rxBuffer, &rxBufferCount);
+        } else {
+          for (int i = 0; i < count; i++) {
+            drv->processData(ctx, buffer[i], rxBuffer, &rxBufferCount);
+          }
+        }
+        LOG_TELEMETRY_WRITE_BUFFER(buffer, count);
+      } while ((count = serial_drv->getBytes(serial_ctx, buffer, sizeof(buffer))) > 0);
+    }
+    return;
+  }
+
+  if (!serial_drv->getByte)
+    return;
+
   uint8_t data;
   if (serial_drv->getByte(serial_ctx, &data) > 0) {
     LOG_TELEMETRY_WRITE_START();
@@ -296,12 +351,7 @@ void telemetryWakeup()
   }
   _telemetryIsPolling = false;
 
-  for (int i=0; i<MAX_TELEMETRY_SENSORS; i++) {
-    const TelemetrySensor & sensor = g_model.telemetrySensors[i];
-    if (sensor.type == TELEM_TYPE_CALCULATED) {
-      telemetryItems[i].eval(sensor);
-    }
-  }
+  evalCalculatedSensors();
 
 #if defined(VARIO)
   if (TELEMETRY_STREAMING() && !IS_FAI_ENABLED()) {
@@ -387,14 +437,12 @@ void telemetryWakeup()
 void telemetryInterrupt10ms()
 {
   if (telemetryStreaming > 0) {
-    bool tick160ms = (telemetryStreaming & 0x0F) == 0;
-    for (int i=0; i<MAX_TELEMETRY_SENSORS; i++) {
-      const TelemetrySensor & sensor = g_model.telemetrySensors[i];
-      if (sensor.type == TELEM_TYPE_CALCULATED) {
-        telemetryItems[i].per10ms(sensor);
-      }
-      if (tick160ms && telemetryItems[i].timeout > 0) {
-        telemetryItems[i].timeout--;
+    calculatedSensorsPer10ms();
+    if ((telemetryStreaming & 0x0F) == 0) {
+      for (auto & telemetryItem: telemetryItems) {
+        if (telemetryItem.timeout > 0) {
+          telemetryItem.timeout--;
+        }
       }
     }
     telemetryStreaming--;
@@ -494,6 +542,26 @@ void logTelemetryWriteByte(uint8_t data)
 {
   f_printf(&g_telemetryFile, " %02X", data);
 }
+
+void logTelemetryWriteBuffer(const uint8_t* data, uint32_t size)
+{
+  static const char hex[] = "0123456789ABCDEF";
+  char text[16 * 3];
+
+  while (size > 0) {
+    uint32_t count = min<uint32_t>(size, 16);
+    char* p = text;
+    for (uint32_t i = 0; i < count; i++) {
+      *p++ = ' ';
+      *p++ = hex[data[i] >> 4];
+      *p++ = hex[data[i] & 0x0F];
+    }
+    UINT written;
+    f_write(&g_telemetryFile, text, p - text, &written);
+    data += count;
+    size -= count;
+  }
+}
 #endif
 
 OutputTelemetryBuffer outputTelemetryBuffer __DMA;
@@ -524,6 +592,12 @@ ModuleSyncStatus::ModuleSyncStatus()
 }
 
 void ModuleSyncStatus::update(uint16_t newRefreshRate, int16_t newInputLag)
+{
+  update(newRefreshRate, newInputLag, getTmr2MHz());
+}
+
+void ModuleSyncStatus::update(uint16_t newRefreshRate, int16_t newInputLag,
+                              uint16_t newFrameTime)
 {
   if (!newRefreshRate)
     return;
@@ -537,6 +611,17 @@ void ModuleSyncStatus::update(uint16_t newRefreshRate, int16_t newInputLag)
   inputLag    = newInputLag;
   currentLag  = newInputLag;
   lastUpdate  = get_tmr10ms();
+  frameTime   = newFrameTime;
+
+  // the lag was measured when the frame was received: a correction applied
+  // since (while the frame waited for the telemetry task) is deducted.
+  // getTmr2MHz() wraps after 32ms, older corrections are ignored
+  uint16_t now = getTmr2MHz();
+  if (lastAdjust && (tmr10ms_t)(lastUpdate - lastAdjust10ms) < 2 &&
+      (uint16_t)(now - lastAdjustTime) < (uint16_t)(now - newFrameTime)) {
+    currentLag -= lastAdjust;
+  }
+  lastAdjust = 0;
 
 #if 0
   TRACE("[SYNC] update rate = %dus; lag = %dus",refreshRate,currentLag);
@@ -567,6 +652,9 @@ uint16_t ModuleSyncStatus::getAdjustedRefreshRate()
   }
 
   currentLag -= newRefreshRate - refreshRate;
+  lastAdjust = newRefreshRate - refreshRate;
+  lastAdjustTime = getTmr2MHz();
+  lastAdjust10ms = get_tmr10ms();
 #if 0
   TRACE("[SYNC] mod rate = %dus; lag = %dus",newRefreshRate,currentLag);
 #endif
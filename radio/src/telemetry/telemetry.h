@@ -57,6 +57,9 @@ constexpr uint8_t TELEMETRY_TIMEOUT10ms = 100; // 1 second
 #define TELEMETRY_RX_PACKET_SIZE       19  // 9 bytes (full packet), worst case 18 bytes with byte-stuffing (+1)
 #endif
 
+// bytes fetched at once from the telemetry serial port
+#define TELEMETRY_RX_CHUNK_SIZE        32
+
 //TODO: remove this public definition
 extern uint8_t telemetryRxBuffer[TELEMETRY_RX_PACKET_SIZE];
 extern uint8_t telemetryRxBufferCount;
@@ -73,6 +76,9 @@ void telemetrySetMirrorCb(void* ctx, void (*fct)(void*, uint8_t));
 // Mirror telemetry byte
 void telemetryMirrorSend(uint8_t data);
 
+// Mirror telemetry bytes
+void telemetryMirrorSendBuffer(const uint8_t* data, uint32_t size);
+
 void telemetryWakeup();
 void telemetryReset();
 
@@ -192,11 +198,14 @@ inline uint8_t modelTelemetryProtocol()
 #if defined(LOG_TELEMETRY) && !defined(SIMU)
 void logTelemetryWriteStart();
 void logTelemetryWriteByte(uint8_t data);
+void logTelemetryWriteBuffer(const uint8_t* data, uint32_t size);
 #define LOG_TELEMETRY_WRITE_START()    logTelemetryWriteStart()
 #define LOG_TELEMETRY_WRITE_BYTE(data) logTelemetryWriteByte(data)
+#define LOG_TELEMETRY_WRITE_BUFFER(data, size) logTelemetryWriteBuffer(data, size)
 #else
 #define LOG_TELEMETRY_WRITE_START()
 #define LOG_TELEMETRY_WRITE_BYTE(data)
+#define LOG_TELEMETRY_WRITE_BUFFER(data, size)
 #endif
 #define TELEMETRY_OUTPUT_BUFFER_SIZE  64
 
@@ -300,6 +309,12 @@ struct ModuleSyncStatus
 
   tmr10ms_t lastUpdate;  // in 10ms
   int16_t   currentLag;  // in us
+  uint16_t  frameTime;   // getTmr2MHz() when the last feedback was received
+
+  // last correction applied to the refresh rate
+  int16_t   lastAdjust;     // in us
+  uint16_t  lastAdjustTime; // getTmr2MHz()
+  tmr10ms_t lastAdjust10ms; // in 10ms
   
   inline bool isValid() const {
     // 2 seconds
@@ -309,6 +324,10 @@ struct ModuleSyncStatus
   // Set feedback from RF module
   void update(uint16_t newRefreshRate, int16_t newInputLag);
 
+  // Set feedback from RF module, received at newFrameTime (getTmr2MHz()):
+  // a correction applied after this time is not part of the lag yet
+  void update(uint16_t newRefreshRate, int16_t newInputLag, uint16_t newFrameTime);
+
   //mark as timeouted
   void invalidate();
 
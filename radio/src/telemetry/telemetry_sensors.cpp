@@ -80,10 +80,178 @@ uint32_t getDistFromEarthAxis(int32_t latitude)
                 12500);
 }
 
+// Calculated sensors dependencies
+//
+// Each sensor has the set of calculated sensors computed from its value, so
+// that a calculated sensor is evaluated again only once one of its sources
+// got a new value, after the calculated sensors it depends on. The graph is
+// rebuilt when the model changes, all calculated sensors are then evaluated
+// once. The 10ms interrupt only uses it while it is up to date.
+typedef uint64_t TelemetrySensorsMask;
+
+static_assert(MAX_TELEMETRY_SENSORS <= 64, "TelemetrySensorsMask too small");
+
+struct CalculatedSensorsGraph {
+  uint16_t revision;                                          // storageRevision the graph was built from
+  volatile bool valid;
+  uint8_t count;
+  uint8_t order[MAX_TELEMETRY_SENSORS];                       // calculated sensors, sources first
+  TelemetrySensorsMask dependents[MAX_TELEMETRY_SENSORS];     // sensors evaluated from each sensor
+  TelemetrySensorsMask totalizers[MAX_TELEMETRY_SENSORS];     // sensors totalizing each sensor
+  TelemetrySensorsMask consumption;                           // sensors integrated every 10ms
+  volatile uint8_t pending[MAX_TELEMETRY_SENSORS];            // a source changed since the last evaluation
+};
+
+static CalculatedSensorsGraph sensorsGraph;
+
+static inline TelemetrySensorsMask sensorsMaskBit(uint8_t index)
+{
+  return TelemetrySensorsMask(1) << index;
+}
+
+static inline bool sensorsGraphCurrent()
+{
+  return sensorsGraph.valid && sensorsGraph.revision == storageRevision;
+}
+
+static void sensorsGraphAdd(uint8_t source, uint8_t index)
+{
+  if (source > 0 && source <= MAX_TELEMETRY_SENSORS)
+    sensorsGraph.dependents[source - 1] |= sensorsMaskBit(index);
+}
+
+static void sensorsGraphBuild()
+{
+  sensorsGraph.valid = false;
+  memclear(sensorsGraph.dependents, sizeof(sensorsGraph.dependents));
+  memclear(sensorsGraph.totalizers, sizeof(sensorsGraph.totalizers));
+  sensorsGraph.consumption = 0;
+
+  TelemetrySensorsMask calculated = 0;
+  for (uint8_t index = 0; index < MAX_TELEMETRY_SENSORS; index++) {
+    const TelemetrySensor & sensor = g_model.telemetrySensors[index];
+    if (sensor.type != TELEM_TYPE_CALCULATED)
+      continue;
+    calculated |= sensorsMaskBit(index);
+    switch (sensor.formula) {
+      case TELEM_FORMULA_ADD:
+      case TELEM_FORMULA_AVERAGE:
+      case TELEM_FORMULA_MIN:
+      case TELEM_FORMULA_MAX:
+      case TELEM_FORMULA_MULTIPLY:
+        for (uint8_t i = 0; i < (sensor.formula == TELEM_FORMULA_MULTIPLY ? 2 : 4); i++) {
+          sensorsGraphAdd(abs(sensor.calc.sources[i]), index);
+        }
+        break;
+      case TELEM_FORMULA_CELL:
+        sensorsGraphAdd(sensor.cell.source, index);
+        break;
+      case TELEM_FORMULA_DIST:
+        sensorsGraphAdd(sensor.dist.gps, index);
+        sensorsGraphAdd(sensor.dist.alt, index);
+        break;
+      case TELEM_FORMULA_CONSUMPTION:
+        sensorsGraph.consumption |= sensorsMaskBit(index);
+        break;
+      case TELEM_FORMULA_TOTALIZE:
+        if (sensor.consumption.source > 0 && sensor.consumption.source <= MAX_TELEMETRY_SENSORS)
+          sensorsGraph.totalizers[sensor.consumption.source - 1] |= sensorsMaskBit(index);
+        break;
+    }
+  }
+
+  // each round places the sensors not depending on the ones left, the
+  // sensors of a cycle are placed last in list order
+  sensorsGraph.count = 0;
+  TelemetrySensorsMask left = calculated;
+  while (left) {
+    TelemetrySensorsMask blocked = 0;
+    for (uint8_t index = 0; index < MAX_TELEMETRY_SENSORS; index++) {
+      if (left & sensorsMaskBit(index))
+        blocked |= (sensorsGraph.dependents[index] | sensorsGraph.totalizers[index]) & ~sensorsMaskBit(index);
+    }
+    if ((left & ~blocked) == 0)
+      blocked = 0;
+    for (uint8_t index = 0; index < MAX_TELEMETRY_SENSORS; index++) {
+      if ((left & ~blocked) & sensorsMaskBit(index)) {
+        sensorsGraph.order[sensorsGraph.count++] = index;
+        sensorsGraph.pending[index] = 1;
+      }
+    }
+    left &= blocked;
+  }
+
+  sensorsGraph.revision = storageRevision;
+  sensorsGraph.valid = true;
+}
+
+// the sensors computed from this item will be evaluated again
+static void sensorsGraphChanged(const TelemetryItem * item)
+{
+  if (item < telemetryItems || item >= telemetryItems + MAX_TELEMETRY_SENSORS || !sensorsGraphCurrent())
+    return;
+
+  TelemetrySensorsMask dependents = sensorsGraph.dependents[item - telemetryItems];
+  for (uint8_t index = 0; dependents; index++, dependents >>= 1) {
+    if (dependents & 1)
+      sensorsGraph.pending[index] = 1;
+  }
+}
+
+// the sensors totalizing this item
+static TelemetrySensorsMask sensorsGraphTotalizers(const TelemetryItem * item, const TelemetrySensor & sensor)
+{
+  if (item >= telemetryItems && item < telemetryItems + MAX_TELEMETRY_SENSORS && sensorsGraphCurrent())
+    return sensorsGraph.totalizers[item - telemetryItems];
+
+  TelemetrySensorsMask totalizers = 0;
+  for (int i=0; i<MAX_TELEMETRY_SENSORS; i++) {
+    TelemetrySensor & it = g_model.telemetrySensors[i];
+    if (it.type == TELEM_TYPE_CALCULATED && it.formula == TELEM_FORMULA_TOTALIZE && &g_model.telemetrySensors[it.consumption.source-1] == &sensor) {
+      totalizers |= sensorsMaskBit(i);
+    }
+  }
+  return totalizers;
+}
+
+void evalCalculatedSensors()
+{
+  if (!sensorsGraphCurrent())
+    sensorsGraphBuild();
+
+  for (uint8_t i = 0; i < sensorsGraph.count; i++) {
+    uint8_t index = sensorsGraph.order[i];
+    if (sensorsGraph.pending[index]) {
+      sensorsGraph.pending[index] = 0;
+      telemetryItems[index].eval(g_model.telemetrySensors[index]);
+    }
+  }
+}
+
+void calculatedSensorsPer10ms()
+{
+  if (sensorsGraphCurrent()) {
+    TelemetrySensorsMask consumption = sensorsGraph.consumption;
+    for (uint8_t index = 0; consumption; index++, consumption >>= 1) {
+      if (consumption & 1)
+        telemetryItems[index].per10ms(g_model.telemetrySensors[index]);
+    }
+  }
+  else {
+    for (int i=0; i<MAX_TELEMETRY_SENSORS; i++) {
+      const TelemetrySensor & sensor = g_model.telemetrySensors[i];
+      if (sensor.type == TELEM_TYPE_CALCULATED) {
+        telemetryItems[i].per10ms(sensor);
+      }
+    }
+  }
+}
+
 void TelemetryItem::setValue(const TelemetrySensor & sensor, const char * val, uint32_t, uint32_t)
 {
   strncpy(text, val, sizeof(text));
   setFresh();
+  sensorsGraphChanged(this);
 }
 
 void TelemetryItem::setValue(const TelemetrySensor &sensor, int32_t val,
@@ -116,6 +284,8 @@ void TelemetryItem::setValue(const TelemetrySensor &sensor, int32_t val,
       cells.count = cellsCount;
     }
     cells.values[cellIndex].set(cellValue);
+    // the cell sensors don't wait for the other cells
+    sensorsGraphChanged(this);
     if (cellIndex+1 == cells.count) {
       newVal = 0;
       for (int i=0; i<cellsCount; i++) {
@@ -166,6 +336,7 @@ void TelemetryItem::setValue(const TelemetrySensor &sensor, int32_t val,
     }
     gps.latitude = newVal;
     setFresh();
+    sensorsGraphChanged(this);
     return;
   }
   else if (unit == UNIT_GPS_LONGITUDE) {
@@ -179,6 +350,7 @@ void TelemetryItem::setValue(const TelemetrySensor &sensor, int32_t val,
     }
     gps.longitude = newVal;
     setFresh();
+    sensorsGraphChanged(this);
     return;
   }
   else if (unit == UNIT_DATETIME_YEAR) {
@@ -256,9 +428,10 @@ void TelemetryItem::setValue(const TelemetrySensor &sensor, int32_t val,
     }
   }
 
-  for (int i=0; i<MAX_TELEMETRY_SENSORS; i++) {
-    TelemetrySensor & it = g_model.telemetrySensors[i];
-    if (it.type == TELEM_TYPE_CALCULATED && it.formula == TELEM_FORMULA_TOTALIZE && &g_model.telemetrySensors[it.consumption.source-1] == &sensor) {
+  TelemetrySensorsMask totalizers = sensorsGraphTotalizers(this, sensor);
+  for (uint8_t i = 0; totalizers; i++, totalizers >>= 1) {
+    if (totalizers & 1) {
+      TelemetrySensor & it = g_model.telemetrySensors[i];
       TelemetryItem & item = telemetryItems[i];
       int32_t increment = it.getValue(val, unit, prec);
       item.setValue(it, item.value+increment, it.unit, it.prec);
@@ -267,6 +440,7 @@ void TelemetryItem::setValue(const TelemetrySensor &sensor, int32_t val,
 
   value = newVal;
   setFresh();
+  sensorsGraphChanged(this);
 }
 
 void TelemetryItem::per10ms(const TelemetrySensor & sensor)
@@ -494,6 +668,75 @@ int lastUsedTelemetryIndex()
   return -1;
 }
 
+// Custom sensors indexed by (id, subId)
+//
+// An open addressing table gives the first sensor of each (id, subId), the
+// other sensors sharing the same id and subId (other instances, or the same
+// instance when the ids are shared) are chained in list order. The instance is
+// not part of the key as isSameInstance() does not compare it exactly. The
+// index is rebuilt when the model changes; the sensors it returns are checked
+// again, so that an entry made obsolete by an edit is only skipped.
+#define TELEMETRY_INDEX_SIZE  128  // power of 2
+
+static_assert(TELEMETRY_INDEX_SIZE >= 2 * MAX_TELEMETRY_SENSORS, "TELEMETRY_INDEX_SIZE too small");
+
+struct TelemetrySensorsIndex {
+  uint16_t revision;                      // storageRevision the index was built from
+  bool valid;
+  uint8_t slots[TELEMETRY_INDEX_SIZE];    // first sensor + 1, 0 when empty
+  uint8_t next[MAX_TELEMETRY_SENSORS];    // next sensor with the same key + 1
+};
+
+static TelemetrySensorsIndex sensorsIndex;
+
+static inline uint8_t sensorsIndexHash(uint16_t id, uint8_t subId)
+{
+  return ((id ^ (id >> 8)) * 31u + subId) & (TELEMETRY_INDEX_SIZE - 1);
+}
+
+// slot holding the given key, or the empty slot where it would go
+static uint8_t sensorsIndexSlot(uint16_t id, uint8_t subId)
+{
+  uint8_t slot = sensorsIndexHash(id, subId);
+  while (true) {
+    uint8_t entry = sensorsIndex.slots[slot];
+    if (!entry)
+      return slot;
+    const TelemetrySensor & sensor = g_model.telemetrySensors[entry - 1];
+    if (sensor.id == id && sensor.subId == subId)
+      return slot;
+    slot = (slot + 1) & (TELEMETRY_INDEX_SIZE - 1);
+  }
+}
+
+static void sensorsIndexBuild()
+{
+  memclear(sensorsIndex.slots, sizeof(sensorsIndex.slots));
+
+  // backwards, so that each sensor is chained in front of the next ones
+  for (int index = MAX_TELEMETRY_SENSORS - 1; index >= 0; index--) {
+    const TelemetrySensor & sensor = g_model.telemetrySensors[index];
+    sensorsIndex.next[index] = 0;
+    if (sensor.type != TELEM_TYPE_CUSTOM)
+      continue;
+    uint8_t slot = sensorsIndexSlot(sensor.id, sensor.subId);
+    sensorsIndex.next[index] = sensorsIndex.slots[slot];
+    sensorsIndex.slots[slot] = index + 1;
+  }
+
+  sensorsIndex.revision = storageRevision;
+  sensorsIndex.valid = true;
+}
+
+// first sensor with the given id and subId, -1 if none
+static int sensorsIndexFirst(uint16_t id, uint8_t subId)
+{
+  if (!sensorsIndex.valid || sensorsIndex.revision != storageRevision)
+    sensorsIndexBuild();
+
+  return sensorsIndex.slots[sensorsIndexSlot(id, subId)] - 1;
+}
+
 template <class T>
 int setTelemetryValue(TelemetryProtocol protocol, uint16_t id, uint8_t subId,
                       uint8_t instance, T value, uint32_t unit = 0,
@@ -501,7 +744,9 @@ int setTelemetryValue(TelemetryProtocol protocol, uint16_t id, uint8_t subId,
 {
   bool sensorFound = false;
 
-  for (int index = 0; index < MAX_TELEMETRY_SENSORS; index++) {
+  // sensors with this id and subId, in list order
+  for (int index = sensorsIndexFirst(id, subId); index >= 0;
+       index = sensorsIndex.next[index] - 1) {
     TelemetrySensor &telemetrySensor = g_model.telemetrySensors[index];
 
     if (telemetrySensor.type == TELEM_TYPE_CUSTOM && telemetrySensor.id == id &&
@@ -522,6 +767,9 @@ int setTelemetryValue(TelemetryProtocol protocol, uint16_t id, uint8_t subId,
 
   int index = availableTelemetryIndex();
   if (index >= 0) {
+    // the new sensor is not indexed yet
+    sensorsIndex.valid = false;
+
     switch (protocol) {
       case PROTOCOL_TELEMETRY_FRSKY_SPORT:
         frskySportSetDefault(index, id, subId, instance);
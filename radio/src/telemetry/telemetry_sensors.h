@@ -137,4 +137,9 @@ extern TelemetryItem telemetryItems[MAX_TELEMETRY_SENSORS];
 extern uint8_t allowNewSensors;
 bool isFaiForbidden(source_t idx);
 
+// evaluates the calculated sensors whose sources changed
+void evalCalculatedSensors();
+// integrates the consumption sensors, from the 10ms interrupt
+void calculatedSensorsPer10ms();
+
 #endif // _TELEMETRY_SENSORS_H_
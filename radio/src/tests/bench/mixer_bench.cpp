@@ -0,0 +1,414 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+// Headless mixer benchmark
+//
+// Drives the mixer stages with synthetic stick and switch sweeps over a
+// built-in "heavy" model (or a YAML model file) and reports the average
+// time per iteration of each stage.
+//
+// With --replay, the inputs recorded on the radio (see input_record.h) are
+// replayed instead, and --outputs dumps the channels outputs of each frame
+// to a CSV file to compare two firmware builds.
+//
+// usage: mixer-bench [--iterations N] [--model FILE.yml] [--replay FILE.rec]
+//                    [--outputs FILE.csv] [--json] [--output FILE]
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+#include "opentx.h"
+#include "model_init.h"
+#include "switches.h"
+#include "input_record.h"
+#include "limits_plan.h"
+#include "hal/adc_driver.h"
+
+#define DEFAULT_ITERATIONS   100000
+#define ITERATIONS_PER_10MS  5        // 2ms mixer period
+#define SWITCH_SWEEP_PERIOD  1000     // iterations between switch moves
+
+extern const etx_hal_adc_driver_t simu_adc_driver;
+
+static uint32_t benchIteration = 0;
+
+// triangle sweep over the whole ADC range, each input with its own phase
+uint16_t simu_get_analog(uint8_t idx)
+{
+  uint32_t phase = (benchIteration * 8 + idx * 512) % 8192;
+  return phase < 4096 ? phase : 8191 - phase;
+}
+
+enum BenchStage {
+  STAGE_GET_ADC,
+  STAGE_GET_SWITCHES,
+  STAGE_EVAL_MIXES,
+  STAGE_EVAL_MIXES_FADE,
+  STAGE_APPLY_LIMITS,
+  STAGE_APPLY_LIMITS_PLAN,
+  STAGE_MIXER_CALCULATIONS,
+  STAGE_COUNT
+};
+
+static const char * const stageNames[STAGE_COUNT] = {
+  "getADC",
+  "getSwitchesPosition",
+  "evalMixes",
+  "evalMixesFade",
+  "applyLimits",
+  "applyLimitsPlan",
+  "doMixerCalculations",
+};
+
+struct StageResult {
+  uint64_t totalNs;
+  uint32_t count;
+};
+
+static StageResult results[STAGE_COUNT];
+
+typedef std::chrono::steady_clock BenchClock;
+
+template <class F>
+static inline void measure(BenchStage stage, F function)
+{
+  auto start = BenchClock::now();
+  function();
+  auto end = BenchClock::now();
+  results[stage].totalNs += std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+  results[stage].count++;
+}
+
+// A model using most of the mixer features: 64 mix lines on 32 channels
+// with curves, slow, channels as sources, flight modes with fade, and
+// 64 logical switches used as a state machine
+static void buildHeavyModel()
+{
+  setModelDefaults();
+
+  // 8 smooth 9 points curves
+  memclear(g_model.curves, sizeof(g_model.curves));
+  memclear(g_model.points, sizeof(g_model.points));
+  for (uint8_t i = 0; i < 8; i++) {
+    g_model.curves[i].type = CURVE_TYPE_STANDARD;
+    g_model.curves[i].points = 4;
+    g_model.curves[i].smooth = (i & 1);
+  }
+  loadCurves();
+  for (uint8_t i = 0; i < 8; i++) {
+    int8_t * points = curveAddress(i);
+    for (uint8_t p = 0; p < 9; p++) {
+      points[p] = -100 + p * 25 - (i * (p & 1) * 3);
+    }
+  }
+
+  // 4 inputs with expo
+  memclear(g_model.expoData, sizeof(g_model.expoData));
+  for (uint8_t i = 0; i < 4; i++) {
+    ExpoData * expo = expoAddress(i);
+    expo->chn = i;
+    expo->srcRaw = MIXSRC_FIRST_STICK + i;
+    expo->weight = 100;
+    expo->mode = 3;
+    expo->curve.type = CURVE_REF_EXPO;
+    expo->curve.value = 30;
+  }
+
+  // 2 lines per channel
+  memclear(g_model.mixData, sizeof(g_model.mixData));
+  for (uint8_t i = 0; i < MAX_MIXERS; i++) {
+    MixData * mix = mixAddress(i);
+    uint8_t ch = (i / 2) % MAX_OUTPUT_CHANNELS;
+    mix->destCh = ch;
+    mix->mltpx = MLTPX_ADD;
+    if (i & 1) {
+      mix->srcRaw = (ch > 0 ? MIXSRC_FIRST_CH + ch - 1 : MIXSRC_FIRST_TRIM);
+      mix->weight = 50;
+      mix->speedUp = 10;
+      mix->speedDown = 10;
+      mix->swtch = SWSRC_FIRST_LOGICAL_SWITCH + (ch % MAX_LOGICAL_SWITCHES);
+    }
+    else {
+      mix->srcRaw = MIXSRC_FIRST_INPUT + (ch % 4);
+      mix->weight = 100;
+      mix->curve.type = CURVE_REF_CUSTOM;
+      mix->curve.value = 1 + (ch % 8);
+      mix->flightModes = (ch & 4 ? 0x02 : 0);
+    }
+  }
+
+  // logical switches: 8 comparisons on inputs, then AND / OR chains
+  memclear(g_model.logicalSw, sizeof(g_model.logicalSw));
+  for (uint8_t i = 0; i < MAX_LOGICAL_SWITCHES; i++) {
+    LogicalSwitchData * ls = lswAddress(i);
+    if (i < 8) {
+      ls->func = LS_FUNC_VPOS;
+      ls->v1 = MIXSRC_FIRST_INPUT + (i % 4);
+      ls->v2 = i * 10 - 40;
+    }
+    else {
+      ls->func = (i & 1 ? LS_FUNC_OR : LS_FUNC_AND);
+      ls->v1 = SWSRC_FIRST_LOGICAL_SWITCH + i - 8;
+      ls->v2 = SWSRC_FIRST_LOGICAL_SWITCH + i - 7;
+    }
+  }
+
+  // flight mode 1 on SA, with fade
+  g_model.flightModeData[1].swtch = SWSRC_FIRST_SWITCH;
+  g_model.flightModeData[1].fadeIn = 5;
+  g_model.flightModeData[1].fadeOut = 5;
+
+  storageDirty(EE_MODEL);
+}
+
+static bool loadModelFile(const char * path)
+{
+  std::string dir(path);
+  std::string filename;
+  size_t pos = dir.find_last_of('/');
+  if (pos == std::string::npos) {
+    filename = dir;
+    dir = ".";
+  }
+  else {
+    filename = dir.substr(pos + 1);
+    dir = dir.substr(0, pos + 1);
+  }
+
+  simuFatfsSetPaths(dir.c_str(), dir.c_str());
+  const char * error = readModel(filename.c_str(), (uint8_t *)&g_model, sizeof(g_model), "");
+  if (error) {
+    fprintf(stderr, "mixer-bench: cannot load %s: %s\n", path, error);
+    return false;
+  }
+
+  loadCurves();
+  storageDirty(EE_MODEL);
+  return true;
+}
+
+static void sweepSwitches()
+{
+  uint32_t step = benchIteration / SWITCH_SWEEP_PERIOD;
+  for (uint8_t i = 0; i < switchGetMaxSwitches(); i++) {
+    simuSetSwitch(i, ((step + i) % 3) - 1);
+  }
+}
+
+// One mixer pass per iteration, in the same sequence as
+// doMixerCalculations(), timing each stage; the slows, delays and fades
+// advance exactly as on the radio
+static void runIteration()
+{
+  if (benchIteration % SWITCH_SWEEP_PERIOD == 0) {
+    sweepSwitches();
+  }
+
+  uint8_t tick10ms = (benchIteration % ITERATIONS_PER_10MS == 0);
+  if (tick10ms) {
+    g_tmr10ms++;
+  }
+
+  // evalMixes() runs the mixes of both flight modes during a fade
+  static uint8_t lastFm = 0;
+  static uint32_t fadeEnd = 0;
+  uint8_t fm = getFlightMode();
+  if (fm != lastFm) {
+    uint8_t fadeTime = max(g_model.flightModeData[lastFm].fadeOut, g_model.flightModeData[fm].fadeIn);
+    fadeEnd = benchIteration + fadeTime * 10 * ITERATIONS_PER_10MS;
+    lastFm = fm;
+  }
+
+  measure(STAGE_MIXER_CALCULATIONS, [=] {
+    measure(STAGE_GET_ADC, [] { getADC(); });
+    measure(STAGE_GET_SWITCHES, [] { getSwitchesPosition(false); });
+    measure(benchIteration < fadeEnd ? STAGE_EVAL_MIXES_FADE : STAGE_EVAL_MIXES, [=] {
+      curvesCacheUpdate();
+      evalMixes(tick10ms);
+    });
+  });
+
+  // the limits are stateless: compare both implementations on the
+  // channels of this pass, without touching the mixer outputs
+  static int16_t output[MAX_OUTPUT_CHANNELS];
+
+  measure(STAGE_APPLY_LIMITS, [] {
+    for (uint8_t i = 0; i < MAX_OUTPUT_CHANNELS; i++) {
+      output[i] = applyLimits(i, chans[i]);
+    }
+  });
+
+  measure(STAGE_APPLY_LIMITS_PLAN, [] {
+    applyLimitsPlan(chans, output);
+  });
+
+  benchIteration++;
+}
+
+static uint32_t runReplay(FILE * outputs)
+{
+  uint32_t frames = 0;
+
+  while (inputReplayNextFrame()) {
+    measure(STAGE_MIXER_CALCULATIONS, [] { doMixerCalculations(); });
+    if (outputs) {
+      fprintf(outputs, "%u", frames);
+      for (uint8_t i = 0; i < MAX_OUTPUT_CHANNELS; i++) {
+        fprintf(outputs, ",%d", channelOutputs[i]);
+      }
+      fprintf(outputs, "\n");
+    }
+    frames++;
+  }
+
+  return frames;
+}
+
+static void printResults(FILE * out, const char * model, uint32_t iterations, bool json)
+{
+  if (json) {
+    fprintf(out, "{\n  \"model\": \"%s\",\n  \"iterations\": %u,\n  \"stages\": {\n",
+           model, iterations);
+    for (uint8_t i = 0; i < STAGE_COUNT; i++) {
+      const StageResult & result = results[i];
+      fprintf(out, "    \"%s\": { \"ns_per_iteration\": %llu, \"samples\": %u }%s\n",
+             stageNames[i],
+             (unsigned long long)(result.count ? result.totalNs / result.count : 0),
+             result.count, i < STAGE_COUNT - 1 ? "," : "");
+    }
+    fprintf(out, "  }\n}\n");
+  }
+  else {
+    fprintf(out, "model: %s, %u iterations\n", model, iterations);
+    for (uint8_t i = 0; i < STAGE_COUNT; i++) {
+      const StageResult & result = results[i];
+      fprintf(out, "  %-22s %8llu ns/iteration (%u samples)\n", stageNames[i],
+             (unsigned long long)(result.count ? result.totalNs / result.count : 0),
+             result.count);
+    }
+  }
+}
+
+int main(int argc, char ** argv)
+{
+  uint32_t iterations = DEFAULT_ITERATIONS;
+  const char * modelFile = nullptr;
+  bool json = false;
+  const char * outputFile = nullptr;
+  const char * replayFile = nullptr;
+  const char * outputsFile = nullptr;
+
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--iterations") && i + 1 < argc) {
+      iterations = strtoul(argv[++i], nullptr, 10);
+    }
+    else if (!strcmp(argv[i], "--model") && i + 1 < argc) {
+      modelFile = argv[++i];
+    }
+    else if (!strcmp(argv[i], "--replay") && i + 1 < argc) {
+      replayFile = argv[++i];
+    }
+    else if (!strcmp(argv[i], "--outputs") && i + 1 < argc) {
+      outputsFile = argv[++i];
+    }
+    else if (!strcmp(argv[i], "--json")) {
+      json = true;
+    }
+    else if (!strcmp(argv[i], "--output") && i + 1 < argc) {
+      outputFile = argv[++i];
+    }
+    else {
+      fprintf(stderr,
+              "usage: %s [--iterations N] [--model FILE.yml] [--replay FILE.rec] "
+              "[--outputs FILE.csv] [--json] [--output FILE]\n",
+              argv[0]);
+      return 1;
+    }
+  }
+
+  simuInit();
+  adcInit(&simu_adc_driver);
+  sourceRangesInit();
+
+  generalDefault();
+  if (modelFile) {
+    if (!loadModelFile(modelFile))
+      return 2;
+  }
+  else {
+    buildHeavyModel();
+  }
+  logicalSwitchesReset();
+
+  // warm up the mixer caches before measuring
+  for (uint8_t i = 0; i < 10; i++) {
+    doMixerCalculations();
+  }
+
+  if (replayFile) {
+    const char * error = inputReplayOpen(replayFile);
+    if (error) {
+      fprintf(stderr, "mixer-bench: cannot replay %s: %s\n", replayFile, error);
+      return 2;
+    }
+
+    FILE * outputs = nullptr;
+    if (outputsFile) {
+      outputs = fopen(outputsFile, "w");
+      if (!outputs) {
+        fprintf(stderr, "mixer-bench: cannot write %s\n", outputsFile);
+        return 2;
+      }
+    }
+
+    iterations = runReplay(outputs);
+
+    if (outputs) {
+      fclose(outputs);
+    }
+    inputReplayClose();
+  }
+  else {
+    for (uint32_t i = 0; i < iterations; i++) {
+      runIteration();
+    }
+  }
+
+  FILE * out = stdout;
+  if (outputFile) {
+    out = fopen(outputFile, "w");
+    if (!out) {
+      fprintf(stderr, "mixer-bench: cannot write %s\n", outputFile);
+      return 2;
+    }
+  }
+
+  printResults(out, modelFile ? modelFile : "heavy", iterations, json);
+
+  if (out != stdout) {
+    fclose(out);
+  }
+
+  return 0;
+}
@@ -20,6 +20,9 @@
  */
 
 #include "gtests.h"
+#include "hal/module_port.h"
+#include "pulses/crossfire.h"
+#include "telemetry/crossfire.h"
 
 #if defined(CROSSFIRE)
 uint8_t createCrossfireChannelsFrame(uint8_t * frame, int16_t * pulses);
@@ -44,5 +47,132 @@ TEST(Crossfire, crc8)
   uint8_t crc = crc8(&frame[2], frame[1]-1);
   ASSERT_EQ(frame[frame[1]+1], crc);
 }
-#endif
 
+TEST(Crossfire, processBuffer)
+{
+  MODEL_RESET();
+  TELEMETRY_RESET();
+  telemetryStreaming = TELEMETRY_TIMEOUT10ms;
+  allowNewSensors = true;
+
+  // vario frame, 100cm/s (1.0m/s)
+  uint8_t frame[] = { UART_SYNC, 0x04, CF_VARIO_ID, 0x00, 0x64, 0x00 };
+  frame[5] = crc8(&frame[2], frame[1] - 1);
+
+  // garbage, then the frame split across reads
+  uint8_t first[] = { 0x55, frame[0], frame[1], frame[2] };
+  auto ctx = modulePortGetState(EXTERNAL_MODULE);
+  uint8_t* rxBuffer = getTelemetryRxBuffer(EXTERNAL_MODULE);
+  uint8_t& rxBufferCount = getTelemetryRxBufferCount(EXTERNAL_MODULE);
+  rxBufferCount = 0;
+
+  CrossfireDriver.processBuffer(ctx, first, sizeof(first), rxBuffer, &rxBufferCount);
+  EXPECT_EQ(3, rxBufferCount);
+  CrossfireDriver.processBuffer(ctx, &frame[3], 3, rxBuffer, &rxBufferCount);
+  EXPECT_EQ(0, rxBufferCount);
+  EXPECT_EQ(10, telemetryItems[0].value);
+
+  // two frames in one read
+  frame[4] = 0x32;
+  frame[5] = crc8(&frame[2], frame[1] - 1);
+  uint8_t both[sizeof(frame) * 2];
+  memcpy(both, frame, sizeof(frame));
+  memcpy(both + sizeof(frame), frame, sizeof(frame));
+  both[sizeof(frame) + 4] = 0x64;
+  both[sizeof(frame) + 5] = crc8(&both[sizeof(frame) + 2], frame[1] - 1);
+  CrossfireDriver.processBuffer(ctx, both, sizeof(both), rxBuffer, &rxBufferCount);
+  EXPECT_EQ(0, rxBufferCount);
+  EXPECT_EQ(10, telemetryItems[0].value);
+  EXPECT_EQ(5, telemetryItems[0].valueMin);
+}
+
+TEST(Crossfire, processFrame)
+{
+  MODEL_RESET();
+  TELEMETRY_RESET();
+  telemetryStreaming = TELEMETRY_TIMEOUT10ms;
+  allowNewSensors = true;
+
+  // vario frames, 1.0m/s then 0.5m/s
+  uint8_t frames[] = { UART_SYNC, 0x04, CF_VARIO_ID, 0x00, 0x64, 0x00,
+                       UART_SYNC, 0x04, CF_VARIO_ID, 0x00, 0x32, 0x00 };
+  frames[5] = crc8(&frames[2], frames[1] - 1);
+  frames[11] = crc8(&frames[8], frames[7] - 1);
+
+  auto ctx = modulePortGetState(EXTERNAL_MODULE);
+  uint8_t* rxBuffer = getTelemetryRxBuffer(EXTERNAL_MODULE);
+  uint8_t& rxBufferCount = getTelemetryRxBufferCount(EXTERNAL_MODULE);
+  rxBufferCount = 0;
+
+  // first frame in place, second one wrapping around the end of the buffer
+  etx_serial_frame_t frame;
+  frame.data[0] = frames;
+  frame.len[0] = 8;
+  frame.data[1] = frames + 8;
+  frame.len[1] = 4;
+  frame.time = 0;
+  CrossfireDriver.processFrame(ctx, &frame, rxBuffer, &rxBufferCount);
+  EXPECT_EQ(0, rxBufferCount);
+  EXPECT_EQ(5, telemetryItems[0].value);
+  EXPECT_EQ(10, telemetryItems[0].valueMax);
+
+  // bad CRC: dropped
+  frames[4] = 0x10;
+  frame.data[0] = frames;
+  frame.len[0] = 6;
+  frame.len[1] = 0;
+  CrossfireDriver.processFrame(ctx, &frame, rxBuffer, &rxBufferCount);
+  EXPECT_EQ(0, rxBufferCount);
+  EXPECT_EQ(5, telemetryItems[0].value);
+}
+
+TEST(Crossfire, timingFrameTime)
+{
+  // timing correction frame: 4000us period, 50us lag
+  uint8_t timing[] = { UART_SYNC, 0x0D, RADIO_ID, 0xEA, 0xEE, 0x10,
+                       0x00, 0x00, 0x9C, 0x40, 0x00, 0x00, 0x01, 0xF4, 0x00 };
+  timing[14] = crc8(&timing[2], timing[1] - 1);
+
+  auto ctx = modulePortGetState(EXTERNAL_MODULE);
+  uint8_t* rxBuffer = getTelemetryRxBuffer(EXTERNAL_MODULE);
+  uint8_t& rxBufferCount = getTelemetryRxBufferCount(EXTERNAL_MODULE);
+  rxBufferCount = 0;
+
+  etx_serial_frame_t frame;
+  frame.data[0] = timing;
+  frame.len[0] = sizeof(timing);
+  frame.data[1] = nullptr;
+  frame.len[1] = 0;
+
+  // the idle line time reaches the module sync status
+  ModuleSyncStatus& status = getModuleSyncStatus(EXTERNAL_MODULE);
+  status = ModuleSyncStatus();
+  frame.time = getTmr2MHz() - 1000;
+  CrossfireDriver.processFrame(ctx, &frame, rxBuffer, &rxBufferCount);
+  EXPECT_EQ(frame.time, status.frameTime);
+  EXPECT_EQ(4000, status.refreshRate);
+  EXPECT_EQ(50, status.inputLag);
+  EXPECT_EQ(50, status.currentLag);
+
+  // the lag is corrected on the next module frame
+  EXPECT_EQ(4050, status.getAdjustedRefreshRate());
+  EXPECT_EQ(0, status.currentLag);
+
+  // frame received before the correction: the lag it reports is already
+  // being corrected
+  frame.time = status.lastAdjustTime - 100;
+  CrossfireDriver.processFrame(ctx, &frame, rxBuffer, &rxBufferCount);
+  EXPECT_EQ(frame.time, status.frameTime);
+  EXPECT_EQ(50, status.inputLag);
+  EXPECT_EQ(0, status.currentLag);
+
+  // frame received after the correction: the lag is new
+  EXPECT_EQ(4000, status.getAdjustedRefreshRate());
+  status.currentLag = 50;
+  EXPECT_EQ(4050, status.getAdjustedRefreshRate());
+  frame.time = getTmr2MHz();
+  CrossfireDriver.processFrame(ctx, &frame, rxBuffer, &rxBufferCount);
+  EXPECT_EQ(frame.time, status.frameTime);
+  EXPECT_EQ(50, status.currentLag);
+}
+#endif
@@ -382,6 +382,7 @@ TEST(FrSkySPORT, frskySetCellVoltageTwoSensors)
   g_model.telemetrySensors[2].prec = 1;
   g_model.telemetrySensors[2].calc.sources[0] = 1;
   g_model.telemetrySensors[2].calc.sources[1] = 2;
+  storageDirty(EE_MODEL);
 
   telemetryWakeup();
 
@@ -406,6 +407,79 @@ TEST(FrSkySPORT, frskySetCellVoltageTwoSensors)
   EXPECT_EQ(telemetryItems[2].valueMax, 287);
 }
 
+TEST(FrSkySPORT, calculatedSensorsOrder)
+{
+  MODEL_RESET();
+  TELEMETRY_RESET();
+  telemetryStreaming = TELEMETRY_TIMEOUT10ms;
+  telemetryData.telemetryValid = 0x07;
+  allowNewSensors = true;
+
+  setTelemetryValue(PROTOCOL_TELEMETRY_FRSKY_SPORT, VFAS_FIRST_ID, 0, 1, 1200, UNIT_VOLTS, 2);
+  setTelemetryValue(PROTOCOL_TELEMETRY_FRSKY_SPORT, VFAS_FIRST_ID, 0, 2, 1100, UNIT_VOLTS, 2);
+
+  // sensor 2 sums sensor 3 (before it in the list) and sensor 0
+  g_model.telemetrySensors[2].init("Sum2", UNIT_VOLTS, 2);
+  g_model.telemetrySensors[2].type = TELEM_TYPE_CALCULATED;
+  g_model.telemetrySensors[2].formula = TELEM_FORMULA_ADD;
+  g_model.telemetrySensors[2].calc.sources[0] = 4;
+  g_model.telemetrySensors[2].calc.sources[1] = 1;
+  g_model.telemetrySensors[3].init("Sum1", UNIT_VOLTS, 2);
+  g_model.telemetrySensors[3].type = TELEM_TYPE_CALCULATED;
+  g_model.telemetrySensors[3].formula = TELEM_FORMULA_ADD;
+  g_model.telemetrySensors[3].calc.sources[0] = 1;
+  g_model.telemetrySensors[3].calc.sources[1] = -2;
+  storageDirty(EE_MODEL);
+
+  telemetryWakeup();
+  EXPECT_EQ(telemetryItems[3].value, 100);
+  EXPECT_EQ(telemetryItems[2].value, 1300);
+
+  // evaluated again only once a source changed
+  telemetryItems[3].value = 0;
+  telemetryWakeup();
+  EXPECT_EQ(telemetryItems[3].value, 0);
+
+  setTelemetryValue(PROTOCOL_TELEMETRY_FRSKY_SPORT, VFAS_FIRST_ID, 0, 2, 1000, UNIT_VOLTS, 2);
+  telemetryWakeup();
+  EXPECT_EQ(telemetryItems[3].value, 200);
+  EXPECT_EQ(telemetryItems[2].value, 1400);
+}
+
+TEST(FrSkySPORT, sharedSensorIds)
+{
+  MODEL_RESET();
+  TELEMETRY_RESET();
+  telemetryStreaming = TELEMETRY_TIMEOUT10ms;
+  telemetryData.telemetryValid = 0x07;
+  allowNewSensors = true;
+
+  // one sensor per instance
+  setTelemetryValue(PROTOCOL_TELEMETRY_FRSKY_SPORT, VFAS_FIRST_ID, 0, 1, 1200, UNIT_VOLTS, 2);
+  setTelemetryValue(PROTOCOL_TELEMETRY_FRSKY_SPORT, VFAS_FIRST_ID, 0, 2, 1100, UNIT_VOLTS, 2);
+  EXPECT_TRUE(g_model.telemetrySensors[1].isAvailable());
+  EXPECT_FALSE(g_model.telemetrySensors[2].isAvailable());
+  EXPECT_EQ(telemetryItems[0].value, 1200);
+  EXPECT_EQ(telemetryItems[1].value, 1100);
+
+  // a copy shares the id and the instance
+  g_model.telemetrySensors[2] = g_model.telemetrySensors[0];
+  storageDirty(EE_MODEL);
+  setTelemetryValue(PROTOCOL_TELEMETRY_FRSKY_SPORT, VFAS_FIRST_ID, 0, 1, 1000, UNIT_VOLTS, 2);
+  EXPECT_EQ(telemetryItems[0].value, 1000);
+  EXPECT_EQ(telemetryItems[1].value, 1100);
+  EXPECT_EQ(telemetryItems[2].value, 1000);
+
+  // all instances match when the ids are ignored
+  g_model.ignoreSensorIds = 1;
+  setTelemetryValue(PROTOCOL_TELEMETRY_FRSKY_SPORT, VFAS_FIRST_ID, 0, 3, 900, UNIT_VOLTS, 2);
+  EXPECT_EQ(telemetryItems[0].value, 900);
+  EXPECT_EQ(telemetryItems[1].value, 900);
+  EXPECT_EQ(telemetryItems[2].value, 900);
+  EXPECT_FALSE(g_model.telemetrySensors[3].isAvailable());
+  g_model.ignoreSensorIds = 0;
+}
+
 void generateSportFasVoltagePacket(uint8_t * packet, uint32_t voltage)
 {
   packet[0] = 0x22; //DATA_ID_FAS
@@ -119,5 +119,37 @@ TEST_F(SpecialFunctionsTest, GvarsInc)
 }
 #endif // #if defined(GVARS)
 
+#if defined(OVERRIDE_CHANNEL_FUNCTION)
+TEST_F(SpecialFunctionsTest, IndexSharesSwitches)
+{
+  simuSetSwitch(0, -1);  // SAdown
+
+  for (uint8_t i : {3, 10, 20}) {
+    g_model.customFn[i].swtch = (i == 20 ? SWSRC_FIRST_SWITCH + 1 : SWSRC_FIRST_SWITCH);
+    g_model.customFn[i].func = FUNC_OVERRIDE_CHANNEL;
+    g_model.customFn[i].all.param = 0;
+    g_model.customFn[i].all.val = i;
+    g_model.customFn[i].active = true;
+  }
+  storageDirty(EE_MODEL);
+
+  evalFunctions(g_model.customFn, modelFunctionsContext);
+  EXPECT_EQ(3, modelFunctionsContext.index.count);
+  EXPECT_EQ(2, modelFunctionsContext.index.switchesCount);
+  // the last active function wins, as when all the slots were scanned
+  EXPECT_EQ(10, safetyCh[0]);
+
+  simuSetSwitch(0, 0);  // SA-
+  evalFunctions(g_model.customFn, modelFunctionsContext);
+  EXPECT_EQ(20, safetyCh[0]);
+
+  g_model.customFn[20].swtch = SWSRC_NONE;
+  storageDirty(EE_MODEL);
+  evalFunctions(g_model.customFn, modelFunctionsContext);
+  EXPECT_EQ(2, modelFunctionsContext.index.count);
+  EXPECT_EQ(OVERRIDE_CHANNEL_UNDEFINED, safetyCh[0]);
+}
+#endif
+
 #endif // #if defined(PCBFRSKY)
 
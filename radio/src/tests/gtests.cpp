@@ -155,6 +155,7 @@ int main(int argc, char **argv)
   QCoreApplication app(argc, argv);
   simuInit();
   adcInit(&simu_adc_driver);
+  sourceRangesInit();
 
 #if !defined(COLORLCD)
   menuLevel = 0;
@@ -29,6 +29,7 @@
 #define SWAP_DEFINED
 #include "opentx.h"
 #include "model_init.h"
+#include "mixer_plan.h"
 #include "switches.h"
 #include "hal/switch_driver.h"
 
@@ -81,7 +82,7 @@ inline void MIXER_RESET()
   memset(channelOutputs, 0, sizeof(channelOutputs));
   memset(chans, 0, sizeof(chans));
   memset(ex_chans, 0, sizeof(ex_chans));
-  memset(act, 0, sizeof(act));
+  mixRuntimeReset();
   memset(swOn, 0, sizeof(swOn));
   mixerCurrentFlightMode = lastFlightMode = 0;
   lastAct = 0;
@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#include "gtests.h"
+#include "logs_encoder.h"
+#include "sdcard.h"
+
+static std::vector<uint8_t> logsBlocks;
+
+static bool logsTestWriteBlock(const uint8_t * block)
+{
+  logsBlocks.insert(logsBlocks.end(), block, block + LOGS_BLOCK_SIZE);
+  return true;
+}
+
+static uint32_t readVarint(const std::vector<uint8_t> & data, size_t & pos)
+{
+  uint32_t value = 0;
+  for (uint8_t shift = 0; ; shift += 7) {
+    uint8_t byte = data[pos++];
+    value |= uint32_t(byte & 0x7F) << shift;
+    if (!(byte & 0x80))
+      return value;
+  }
+}
+
+static int32_t readDelta(const std::vector<uint8_t> & data, size_t & pos)
+{
+  uint32_t value = readVarint(data, pos);
+  return int32_t(value >> 1) ^ -int32_t(value & 1);
+}
+
+TEST(Logs, encoder)
+{
+  static LogsEncoder encoder;
+  logsBlocks.clear();
+  encoder.init(logsTestWriteBlock);
+
+  encoder.beginHeader(2);
+  encoder.addColumn(LOGS_COLUMN_VALUE, 1, "Alt(m)");
+  encoder.addColumn(LOGS_COLUMN_TEXT, 0, "FM");
+  EXPECT_TRUE(logsBlocks.empty());
+
+  const int32_t altitudes[] = { 1000, 1002, 999, -70000, 1 << 30 };
+  for (auto altitude: altitudes) {
+    encoder.beginRow();
+    encoder.addValue(altitude);
+    encoder.addText("ACRO");
+  }
+  encoder.flush();
+  EXPECT_FALSE(encoder.hasError());
+  ASSERT_EQ(logsBlocks.size(), (size_t)LOGS_BLOCK_SIZE);
+
+  size_t pos = 0;
+  EXPECT_EQ(logsBlocks[pos++], LOGS_RECORD_HEADER);
+  EXPECT_EQ(memcmp(&logsBlocks[pos], LOGS_MAGIC, 6), 0);
+  pos += 6;
+  EXPECT_EQ(logsBlocks[pos++], LOGS_VERSION);
+  EXPECT_EQ(readVarint(logsBlocks, pos), 2u);
+  EXPECT_EQ(logsBlocks[pos++], LOGS_COLUMN_VALUE);
+  EXPECT_EQ(logsBlocks[pos++], 1);
+  EXPECT_STREQ((const char *)&logsBlocks[pos], "Alt(m)");
+  pos += 7;
+  EXPECT_EQ(logsBlocks[pos++], LOGS_COLUMN_TEXT);
+  EXPECT_EQ(logsBlocks[pos++], 0);
+  EXPECT_STREQ((const char *)&logsBlocks[pos], "FM");
+  pos += 3;
+
+  // small changes take a single byte
+  const size_t sizes[] = { 8, 7, 7, 9, 11 };
+  int32_t altitude = 0;
+  for (unsigned i = 0; i < DIM(altitudes); i++) {
+    const int32_t expected = altitudes[i];
+    const size_t start = pos;
+    EXPECT_EQ(logsBlocks[pos++], LOGS_RECORD_ROW);
+    altitude += readDelta(logsBlocks, pos);
+    EXPECT_EQ(altitude, expected);
+    EXPECT_EQ(readVarint(logsBlocks, pos), 4u);
+    EXPECT_EQ(memcmp(&logsBlocks[pos], "ACRO", 4), 0);
+    pos += 4;
+    EXPECT_EQ(pos - start, sizes[i]);
+  }
+
+  EXPECT_EQ(logsBlocks[pos], LOGS_RECORD_END);
+}
+
+TEST(Logs, encoderBlocks)
+{
+  static LogsEncoder encoder;
+  logsBlocks.clear();
+  encoder.init(logsTestWriteBlock);
+
+  encoder.beginHeader(1);
+  encoder.addColumn(LOGS_COLUMN_VALUE, 0, "CH1(us)");
+
+  // rows span blocks, only full blocks are written
+  for (int i = 0; i < 300; i++) {
+    encoder.beginRow();
+    encoder.addValue(i & 1 ? 1000 : 2000);
+  }
+  EXPECT_EQ(logsBlocks.size(), (size_t)LOGS_BLOCK_SIZE);
+
+  // the first row after an end of block is encoded from 0
+  encoder.flush();
+  ASSERT_EQ(logsBlocks.size(), (size_t)2 * LOGS_BLOCK_SIZE);
+  encoder.beginRow();
+  encoder.addValue(1500);
+  encoder.flush();
+  ASSERT_EQ(logsBlocks.size(), (size_t)3 * LOGS_BLOCK_SIZE);
+  size_t pos = 2 * LOGS_BLOCK_SIZE;
+  EXPECT_EQ(logsBlocks[pos++], LOGS_RECORD_ROW);
+  EXPECT_EQ(readDelta(logsBlocks, pos), 1500);
+}
+
+TEST(Logs, periodParam)
+{
+  // the periods of the former models are kept
+  EXPECT_EQ(10, logsPeriod10ms(1));
+  EXPECT_EQ(2550, logsPeriod10ms(255));
+  EXPECT_EQ(1, logsPeriodIndex(1));
+
+  // fast periods, sorted before the 100ms ones in the editors
+  EXPECT_EQ(1, logsPeriod10ms(LOGS_PERIOD_FAST_PARAM + 1));
+  EXPECT_EQ(LOGS_PERIOD_FAST_COUNT, logsPeriod10ms(LOGS_PERIOD_FAST_PARAM + LOGS_PERIOD_FAST_COUNT));
+  EXPECT_EQ(1 - LOGS_PERIOD_FAST_COUNT, logsPeriodIndex(LOGS_PERIOD_FAST_PARAM + 1));
+  EXPECT_EQ(0, logsPeriodIndex(LOGS_PERIOD_FAST_PARAM + LOGS_PERIOD_FAST_COUNT));
+
+  for (int16_t index = 1 - LOGS_PERIOD_FAST_COUNT; index <= 255; index++) {
+    int16_t param = logsPeriodParam(index);
+    EXPECT_EQ(index, logsPeriodIndex(param));
+    if (index > 1 - LOGS_PERIOD_FAST_COUNT)
+      EXPECT_LT(logsPeriod10ms(logsPeriodParam(index - 1)), logsPeriod10ms(param));
+  }
+}
@@ -20,6 +20,16 @@
  */
 
 #include "gtests.h"
+#include "location.h"
+#include "input_record.h"
+#include "limits_plan.h"
+#include "mixer_plan.h"
+#include "input_plan.h"
+#include "mixer_cost.h"
+#include "mixer_outputs.h"
+#include "mixer_scheduler.h"
+#include "latency_histogram.h"
+#include "pulses/rf_latency.h"
 #include "hal/adc_driver.h"
 
 class TrimsTest : public OpenTxTest {};
@@ -490,6 +500,22 @@ TEST_F(TrimsTest, InstantTrim)
 #endif
 }
 
+TEST_F(TrimsTest, InstantTrimUnusedInput)
+{
+  // no mix reads the aileron input: instantTrim() evaluates it anyway
+  memclear(g_model.mixData, sizeof(g_model.mixData));
+  storageDirty(EE_MODEL);
+  inputPlanReset();
+  evalMixes(1);
+  anaSetFiltered(AIL_STICK, 50);
+  instantTrim();
+#if defined(STICK_DEAD_ZONE)
+  EXPECT_EQ(23, getTrimValue(0, AIL_STICK));
+#else
+  EXPECT_EQ(25, getTrimValue(0, AIL_STICK));
+#endif
+}
+
 TEST_F(TrimsTest, InstantTrimNegativeCurve)
 {
   ExpoData *expo = expoAddress(AIL_STICK);
@@ -524,6 +550,43 @@ TEST(Curves, LinearIntpol)
   EXPECT_EQ(applyCustomCurve(-192, 0), -192);
 }
 
+TEST(Curves, SmoothCurveFollowsEdits)
+{
+  SYSTEM_RESET();
+  MODEL_RESET();
+  MIXER_RESET();
+  setModelDefaults();
+  g_model.curves[0].smooth = 1;
+  for (int8_t i=-2; i<=2; i++) {
+    g_model.points[2+i] = 50*i;
+  }
+  EXPECT_EQ(applyCustomCurve(-1024, 0), -1024);
+  EXPECT_EQ(applyCustomCurve(0, 0), 0);
+  EXPECT_EQ(applyCustomCurve(1024, 0), 1024);
+  EXPECT_NEAR(applyCustomCurve(-192, 0), -192, 1);
+  int uncached = applyCustomCurve(-192, 0);
+
+  // the cache only holds the curves used by the model
+  g_model.mixData[0].destCh = 0;
+  g_model.mixData[0].srcRaw = MIXSRC_Ail;
+  g_model.mixData[0].weight = 100;
+  g_model.mixData[0].curve.type = CURVE_REF_CUSTOM;
+  g_model.mixData[0].curve.value = 1;
+  storageDirty(EE_MODEL);
+  curvesCacheUpdate();
+  EXPECT_EQ(applyCustomCurve(-192, 0), uncached);
+
+  // flatten the curve
+  for (int8_t i=-2; i<=2; i++) {
+    g_model.points[2+i] = 0;
+  }
+  storageDirty(EE_MODEL);
+  curvesCacheUpdate();
+  EXPECT_EQ(applyCustomCurve(-1024, 0), 0);
+  EXPECT_EQ(applyCustomCurve(-192, 0), 0);
+  EXPECT_EQ(applyCustomCurve(700, 0), 0);
+}
+
 
 
 TEST_F(MixerTest, InfiniteRecursiveChannels)
@@ -543,6 +606,38 @@ TEST_F(MixerTest, InfiniteRecursiveChannels)
   EXPECT_EQ(chans[0], 0);
 }
 
+TEST_F(MixerTest, ChannelsInDependencyOrder)
+{
+  // CH1 <- CH2 <- CH3 <- MAX, computed in a single pass
+  g_model.mixData[0].destCh = 0;
+  g_model.mixData[0].srcRaw = MIXSRC_FIRST_CH + 1;
+  g_model.mixData[0].weight = 100;
+  g_model.mixData[1].destCh = 1;
+  g_model.mixData[1].srcRaw = MIXSRC_FIRST_CH + 2;
+  g_model.mixData[1].weight = 50;
+  g_model.mixData[2].destCh = 2;
+  g_model.mixData[2].srcRaw = MIXSRC_MAX;
+  g_model.mixData[2].weight = 100;
+  evalFlightModeMixes(e_perout_mode_normal, 0);
+  EXPECT_EQ(chans[2], CHANNEL_MAX);
+  EXPECT_EQ(chans[1], CHANNEL_MAX / 2);
+  EXPECT_EQ(chans[0], CHANNEL_MAX / 2);
+  EXPECT_EQ(mixPlan.items[0].destCh, 2);
+  EXPECT_FALSE(isMixInChannelLoop(0));
+  EXPECT_FALSE(isMixInChannelLoop(1));
+
+  // CH1 <-> CH2 loop: CH1 reads CH2 from the previous cycle
+  g_model.mixData[1].srcRaw = MIXSRC_FIRST_CH;
+  g_model.mixData[2].destCh = 1;
+  storageDirty(EE_MODEL);
+  evalFlightModeMixes(e_perout_mode_normal, 0);
+  EXPECT_TRUE(isMixInChannelLoop(0));
+  EXPECT_TRUE(isMixInChannelLoop(1));
+  EXPECT_FALSE(isMixInChannelLoop(2));
+  EXPECT_EQ(chans[0], 0);
+  EXPECT_EQ(chans[1], CHANNEL_MAX);
+}
+
 TEST_F(MixerTest, BlockingChannel)
 {
   g_model.mixData[0].destCh = 0;
@@ -642,6 +737,155 @@ TEST_F(MixerTest, SlowOnSwitchSource)
   CHECK_SLOW_MOVEMENT(0, +1, 500);
 }
 
+TEST_F(MixerTest, DifferentialThenMultiply)
+{
+  memclear(g_model.mixData, sizeof(g_model.mixData));
+  g_model.mixData[0].destCh = 0;
+  g_model.mixData[0].srcRaw = MIXSRC_MAX;
+  g_model.mixData[0].weight = -100;
+  g_model.mixData[0].curve.type = CURVE_REF_DIFF;
+  g_model.mixData[0].curve.value = 50;
+  g_model.mixData[1].destCh = 0;
+  g_model.mixData[1].srcRaw = MIXSRC_MAX;
+  g_model.mixData[1].weight = 50;
+  g_model.mixData[1].mltpx = MLTPX_MUL;
+  storageDirty(EE_MODEL);
+
+  evalFlightModeMixes(e_perout_mode_normal, 0);
+  // -100% reduced by the differential to -50%, then multiplied by 50%
+  EXPECT_EQ(-CHANNEL_MAX / 4, chans[0]);
+}
+
+// estimate (us) of a cost given in 0.1us on the STM32F2
+#if defined(STM32F4)
+  #define MIXER_COST_US(cost)   ((cost) * MIXER_COST_CPU_PERCENT_STM32F4 / 1000)
+#else
+  #define MIXER_COST_US(cost)   ((cost) * MIXER_COST_CPU_PERCENT_STM32F2 / 1000)
+#endif
+
+TEST_F(MixerTest, MixerCostEstimate)
+{
+  memclear(g_model.expoData, sizeof(g_model.expoData));
+  memclear(g_model.mixData, sizeof(g_model.mixData));
+  memclear(g_model.logicalSw, sizeof(g_model.logicalSw));
+  memclear(g_model.customFn, sizeof(g_model.customFn));
+  memclear(g_eeGeneral.customFn, sizeof(g_eeGeneral.customFn));
+  storageDirty(EE_MODEL);
+  // base cost only
+  EXPECT_EQ(MIXER_COST_US(600), mixerCostEstimate());
+
+  // 2 inputs, one with an expo: 2 x 2.5 + 1.5
+  for (uint8_t i = 0; i < 2; i++) {
+    g_model.expoData[i].mode = 3;
+    g_model.expoData[i].chn = i;
+    g_model.expoData[i].srcRaw = MIXSRC_FIRST_STICK + i;
+    g_model.expoData[i].weight = 100;
+  }
+  g_model.expoData[1].curve.type = CURVE_REF_EXPO;
+  g_model.expoData[1].curve.value = 30;
+  // 2 mixes, one with a smooth custom curve and a slow: 2 x 4 + 2.5 + 2 + 1
+  for (uint8_t i = 0; i < 2; i++) {
+    g_model.mixData[i].destCh = i;
+    g_model.mixData[i].srcRaw = MIXSRC_FIRST_INPUT + i;
+    g_model.mixData[i].weight = 100;
+  }
+  g_model.mixData[1].curve.type = CURVE_REF_CUSTOM;
+  g_model.mixData[1].curve.value = 1;
+  g_model.curves[0].smooth = 1;
+  g_model.mixData[1].speedUp = 10;
+  // 1 logical switch: 1
+  g_model.logicalSw[0].func = LS_FUNC_VPOS;
+  // 1 special function with a switch and 1 without: 0.5
+  g_model.customFn[0].swtch = SWSRC_FIRST_SWITCH;
+  g_model.customFn[0].func = FUNC_PLAY_SOUND;
+  g_model.customFn[1].func = FUNC_PLAY_SOUND;
+  // 1 global function with a switch: 0.5
+  g_eeGeneral.customFn[0].swtch = SWSRC_FIRST_SWITCH;
+  g_eeGeneral.customFn[0].func = FUNC_PLAY_SOUND;
+  storageDirty(EE_MODEL);
+  EXPECT_EQ(MIXER_COST_US(820), mixerCostEstimate());
+
+  // global functions disabled in the model
+  g_model.radioGFDisabled = OVERRIDE_OFF;
+  storageDirty(EE_MODEL);
+  EXPECT_EQ(MIXER_COST_US(815), mixerCostEstimate());
+  EXPECT_FALSE(isMixerCostHigh());
+
+  // a slow on every mix line: 60 + MAX_MIXERS x 5
+  memclear(g_model.expoData, sizeof(g_model.expoData));
+  memclear(g_model.logicalSw, sizeof(g_model.logicalSw));
+  memclear(g_model.customFn, sizeof(g_model.customFn));
+  for (uint8_t i = 0; i < MAX_MIXERS; i++) {
+    g_model.mixData[i].destCh = i % MAX_OUTPUT_CHANNELS;
+    g_model.mixData[i].srcRaw = MIXSRC_MAX;
+    g_model.mixData[i].curve.value = 0;
+    g_model.mixData[i].speedUp = 10;
+  }
+  storageDirty(EE_MODEL);
+  EXPECT_EQ(MIXER_COST_US(600 + MAX_MIXERS * 50), mixerCostEstimate());
+  EXPECT_FALSE(isMixerCostHigh());
+}
+
+TEST_F(MixerTest, OutputsSnapshot)
+{
+  memclear(g_model.mixData, sizeof(g_model.mixData));
+  g_model.mixData[0].destCh = 0;
+  g_model.mixData[0].mltpx = MLTPX_ADD;
+  g_model.mixData[0].srcRaw = MIXSRC_MAX;
+  g_model.mixData[0].weight = 100;
+  g_model.logicalSw[1].func = LS_FUNC_VPOS;
+  g_model.logicalSw[1].v1 = MIXSRC_MAX;
+  g_model.logicalSw[1].v2 = 0;
+  storageDirty(EE_MODEL);
+
+  MixerOutputs outputs;
+  uint32_t seq = mixerOutputsRead(outputs);
+  evalMixes(1);
+  EXPECT_EQ(seq + 1, mixerOutputsRead(outputs));
+  EXPECT_EQ(RESX, outputs.channels[0]);
+  EXPECT_EQ(RESX, outputs.mixes[0]);
+  EXPECT_EQ(0, outputs.channels[1]);
+  EXPECT_EQ((uint64_t)1 << 1, outputs.logicalSwitches);
+
+  // the UI snapshot only changes when refreshed
+  g_model.mixData[0].weight = -100;
+  storageDirty(EE_MODEL);
+  mixerOutputsRefresh();
+  evalMixes(1);
+  EXPECT_EQ(RESX, mixerOutputs().channels[0]);
+  mixerOutputsRefresh();
+  EXPECT_EQ(-RESX, mixerOutputs().channels[0]);
+}
+
+TEST_F(MixerTest, SlowStateFollowsLine)
+{
+  g_model.mixData[0].destCh = 0;
+  g_model.mixData[0].mltpx = MLTPX_ADD;
+  g_model.mixData[0].srcRaw = MIXSRC_MAX;
+  g_model.mixData[0].weight = 100;
+  g_model.mixData[0].speedUp = 50;
+  g_model.mixData[0].speedDown = 50;
+  storageDirty(EE_MODEL);
+
+  s_mixer_first_run_done = true;
+  evalFlightModeMixes(e_perout_mode_normal, 0);
+  CHECK_SLOW_MOVEMENT(0, +1, 100);
+
+  // CH2 is now computed before CH1, and its slowed line takes the first slot
+  g_model.mixData[1].destCh = 0;
+  g_model.mixData[1].srcRaw = MIXSRC_FIRST_CH + 1;
+  g_model.mixData[1].weight = 0;
+  g_model.mixData[2].destCh = 1;
+  g_model.mixData[2].srcRaw = MIXSRC_MAX;
+  g_model.mixData[2].weight = 100;
+  g_model.mixData[2].speedUp = 10;
+  storageDirty(EE_MODEL);
+
+  CHECK_SLOW_MOVEMENT(0, +1, 150);
+  EXPECT_EQ(0, mixPlan.items[1].index);
+  EXPECT_EQ(1, mixPlan.items[1].state);
+}
+
 TEST_F(MixerTest, SlowDisabledOnStartup)
 {
   g_model.mixData[0].destCh = 0;
@@ -708,6 +952,288 @@ TEST_F(MixerTest, SlowOnMultiply)
   CHECK_NO_MOVEMENT(0, CHANNEL_MAX, 250);
 }
 
+TEST_F(MixerTest, MixPlanFollowsModelEdits)
+{
+  g_model.mixData[0].destCh = 0;
+  g_model.mixData[0].mltpx = MLTPX_ADD;
+  g_model.mixData[0].srcRaw = MIXSRC_MAX;
+  g_model.mixData[0].weight = 100;
+  evalFlightModeMixes(e_perout_mode_normal, 0);
+  EXPECT_EQ(chans[0], CHANNEL_MAX);
+
+  g_model.mixData[0].weight = 50;
+  g_model.mixData[0].offset = 25;
+  storageDirty(EE_MODEL);
+  evalFlightModeMixes(e_perout_mode_normal, 0);
+  EXPECT_EQ(chans[0], CHANNEL_MAX * 3 / 4);
+
+  g_model.mixData[0].destCh = 5;
+  storageDirty(EE_MODEL);
+  evalFlightModeMixes(e_perout_mode_normal, 0);
+  EXPECT_EQ(chans[0], 0);
+  EXPECT_EQ(chans[5], CHANNEL_MAX * 3 / 4);
+}
+
+TEST_F(MixerTest, LimitsPlanMatchesApplyLimits)
+{
+#if defined(OVERRIDE_CHANNEL_FUNCTION)
+  for (uint8_t ch = 0; ch < MAX_OUTPUT_CHANNELS; ch++) {
+    safetyCh[ch] = OVERRIDE_CHANNEL_UNDEFINED;
+  }
+#endif
+
+  uint32_t seed = 12345;
+  auto random = [&seed](int32_t min, int32_t max) {
+    seed = seed * 1103515245 + 12345;
+    return min + int32_t((seed >> 8) % uint32_t(max - min + 1));
+  };
+
+  const int32_t specialValues[] = { 0, 1, -1, 255, -255, 256, -256,
+                                    RESXl * 256, -RESXl * 256,
+                                    RESXl * 256 + 1, -RESXl * 256 - 1 };
+
+  for (int pass = 0; pass < 50; pass++) {
+    for (uint8_t ch = 0; ch < MAX_OUTPUT_CHANNELS; ch++) {
+      LimitData * lim = limitAddress(ch);
+      lim->min = random(-500, 500);
+      lim->max = random(-500, 500);
+      lim->offset = random(-1000, 1000);
+      lim->revert = random(0, 1);
+      lim->symetrical = random(0, 1);
+      lim->curve = 0;
+    }
+#if defined(GVARS)
+    // min, max and offset from a GVar
+    limitAddress(1)->max = -GV1_LARGE;
+    limitAddress(2)->min = -GV1_LARGE;
+    limitAddress(3)->offset = -GV1_LARGE;
+    setGVarValue(0, random(-1000, 1000), 0);
+#endif
+    limitAddress(4)->curve = 1;
+    limitAddress(5)->curve = -1;
+    for (uint8_t i = 0; i < 5; i++) {
+      g_model.points[i] = random(-100, 100);
+    }
+    storageDirty(EE_MODEL);
+
+    int32_t values[MAX_OUTPUT_CHANNELS];
+    int16_t outputs[MAX_OUTPUT_CHANNELS];
+    for (int sweep = 0; sweep < 20; sweep++) {
+      for (uint8_t ch = 0; ch < MAX_OUTPUT_CHANNELS; ch++) {
+        if (sweep < (int)DIM(specialValues))
+          values[ch] = specialValues[sweep];
+        else
+          values[ch] = random(-300000, 300000);
+      }
+      applyLimitsPlan(values, outputs);
+      for (uint8_t ch = 0; ch < MAX_OUTPUT_CHANNELS; ch++) {
+        ASSERT_EQ(applyLimits(ch, values[ch]), outputs[ch])
+            << "pass " << pass << " channel " << (int)ch << " value " << values[ch];
+      }
+    }
+  }
+}
+
+TEST_F(MixerTest, LimitsPlanOverrides)
+{
+#if defined(OVERRIDE_CHANNEL_FUNCTION)
+  for (uint8_t ch = 0; ch < MAX_OUTPUT_CHANNELS; ch++) {
+    safetyCh[ch] = OVERRIDE_CHANNEL_UNDEFINED;
+  }
+#endif
+
+  int32_t values[MAX_OUTPUT_CHANNELS] = { RESXl * 256 };
+  int16_t outputs[MAX_OUTPUT_CHANNELS];
+
+  applyLimitsPlan(values, outputs);
+  EXPECT_EQ(RESX, outputs[0]);
+  EXPECT_EQ(0, outputs[1]);
+
+  g_model.limitData[1].offset = 500;
+  storageDirty(EE_MODEL);
+  applyLimitsPlan(values, outputs);
+  EXPECT_EQ(applyLimits(1, 0), outputs[1]);
+  EXPECT_EQ(512, outputs[1]);
+
+#if defined(OVERRIDE_CHANNEL_FUNCTION)
+  safetyCh[0] = -50;
+  applyLimitsPlan(values, outputs);
+  EXPECT_EQ(applyLimits(0, values[0]), outputs[0]);
+  EXPECT_EQ(-RESX / 2, outputs[0]);
+  safetyCh[0] = OVERRIDE_CHANNEL_UNDEFINED;
+#endif
+}
+
+#if defined(GVARS)
+TEST_F(MixerTest, GVarResolvedPerFlightMode)
+{
+  // FM2 inherits from FM1 which inherits from FM0
+  g_model.flightModeData[0].gvars[0] = 50;
+  g_model.flightModeData[1].gvars[0] = GVAR_MAX + 1;
+  g_model.flightModeData[2].gvars[0] = GVAR_MAX + 2;
+  storageDirty(EE_MODEL);
+  EXPECT_EQ(0, getGVarFlightMode(2, 0));
+  EXPECT_EQ(50, getGVarValue(0, 2));
+  EXPECT_EQ(-50, getGVarValue(-1, 1));
+
+  // set from a flight mode: the value is written where it is inherited from,
+  // the caches built from the model structure stay valid
+  uint16_t revision = storageRevision;
+  setGVarValue(0, 30, 2);
+  EXPECT_EQ(revision, storageRevision);
+  EXPECT_NE(0, storageDirtyMsk & EE_MODEL);
+  EXPECT_EQ(30, g_model.flightModeData[0].gvars[0]);
+  EXPECT_EQ(30, getGVarValue(0, 0));
+  EXPECT_EQ(30, getGVarValue(0, 1));
+  EXPECT_EQ(30, getGVarValue(0, 2));
+
+  // own value in FM1 (model editor)
+  g_model.flightModeData[1].gvars[0] = 10;
+  storageDirty(EE_MODEL);
+  EXPECT_EQ(30, getGVarValue(0, 0));
+  EXPECT_EQ(10, getGVarValue(0, 1));
+  EXPECT_EQ(10, getGVarValue(0, 2));
+}
+#endif
+
+TEST_F(MixerTest, InputPlanSkipsUnusedInputs)
+{
+  memclear(g_model.expoData, sizeof(g_model.expoData));
+  memclear(g_model.mixData, sizeof(g_model.mixData));
+  for (uint8_t i = 0; i < 3; i++) {
+    ExpoData * expo = expoAddress(i);
+    expo->srcRaw = MIXSRC_MAX;
+    expo->chn = i;
+    expo->mode = 3;
+    expo->weight = 100 - 25 * i;
+  }
+  expoAddress(2)->offset = 10;
+  g_model.mixData[0].destCh = 0;
+  g_model.mixData[0].srcRaw = MIXSRC_FIRST_INPUT;
+  g_model.mixData[0].weight = 100;
+  g_model.logicalSw[0].func = LS_FUNC_VPOS;
+  g_model.logicalSw[0].v1 = MIXSRC_FIRST_INPUT + 2;
+  storageDirty(EE_MODEL);
+
+  inputPlanReset();
+  inputsRequested = 0;
+  anas[1] = 0;
+  evalFlightModeMixes(e_perout_mode_normal, 0);
+  EXPECT_EQ(RESX, anas[0]);
+  EXPECT_EQ(0, anas[1]);
+  EXPECT_TRUE(isExpoActive(0));
+
+  // read from a screen or a script
+  getValue(MIXSRC_FIRST_INPUT + 1);
+  evalFlightModeMixes(e_perout_mode_normal, 0);
+
+  int16_t reference[MAX_INPUTS] = {0};
+  applyExpos(reference, e_perout_mode_inactive_flight_mode);
+  for (uint8_t i = 0; i < 3; i++) {
+    EXPECT_EQ(reference[i], anas[i]);
+  }
+  EXPECT_EQ(RESX * 3 / 4, anas[1]);
+
+  // the request survives the model edits
+  storageDirty(EE_MODEL);
+  anas[1] = 0;
+  evalFlightModeMixes(e_perout_mode_normal, 0);
+  EXPECT_EQ(RESX * 3 / 4, anas[1]);
+}
+
+TEST(LatencyHistogram, Percentiles)
+{
+  LatencyHistogram histogram;
+  histogram.reset();
+  EXPECT_EQ(0, histogram.getPercentile(990));
+
+  for (int i = 0; i < 990; i++) {
+    histogram.add(100);
+  }
+  for (int i = 0; i < 9; i++) {
+    histogram.add(1000);
+  }
+  histogram.add(5000);
+
+  EXPECT_EQ(1000u, histogram.getCount());
+  EXPECT_EQ(5000, histogram.getMax());
+  EXPECT_EQ(1u, histogram.getBucket(LatencyHistogram::bucketIndex(5000)));
+  EXPECT_EQ(127, histogram.getPercentile(500));
+  EXPECT_EQ(127, histogram.getPercentile(990));
+  EXPECT_EQ(1023, histogram.getPercentile(999));
+  EXPECT_EQ(5000, histogram.getPercentile(1000));
+}
+
+TEST(RfLatency, ResetOnProtocolChange)
+{
+  rfLatencyReset();
+  channelOutputsSampleTime = 100;
+  channelOutputsTime = 300;
+  rfLatencyAddFrame(EXTERNAL_MODULE, PROTOCOL_CHANNELS_CROSSFIRE);
+  rfLatencyAddFrame(EXTERNAL_MODULE, PROTOCOL_CHANNELS_CROSSFIRE);
+  EXPECT_EQ(PROTOCOL_CHANNELS_CROSSFIRE, rfLatencyGetProtocol(EXTERNAL_MODULE));
+  EXPECT_EQ(2u, rfLatencyGet(EXTERNAL_MODULE, RF_LATENCY_TOTAL).getCount());
+  EXPECT_EQ(200, rfLatencyGet(EXTERNAL_MODULE, RF_LATENCY_MIXER).getMax());
+
+  rfLatencyAddFrame(EXTERNAL_MODULE, PROTOCOL_CHANNELS_MULTIMODULE);
+  EXPECT_EQ(PROTOCOL_CHANNELS_MULTIMODULE, rfLatencyGetProtocol(EXTERNAL_MODULE));
+  EXPECT_EQ(1u, rfLatencyGet(EXTERNAL_MODULE, RF_LATENCY_TOTAL).getCount());
+}
+
+TEST_F(MixerTest, InputRecordReplay)
+{
+  const int frames = 300;
+  int32_t recorded[frames][2];
+
+  g_model.mixData[0].destCh = 0;
+  g_model.mixData[0].mltpx = MLTPX_ADD;
+  g_model.mixData[0].srcRaw = MIXSRC_FIRST_SWITCH;
+  g_model.mixData[0].weight = 100;
+  g_model.mixData[0].speedUp = 10;
+  g_model.mixData[0].speedDown = 10;
+  g_model.mixData[1].destCh = 1;
+  g_model.mixData[1].mltpx = MLTPX_ADD;
+  g_model.mixData[1].srcRaw = MIXSRC_FIRST_TRIM;
+  g_model.mixData[1].weight = 100;
+  storageDirty(EE_MODEL);
+
+  simuFatfsSetPaths(TESTS_BUILD_PATH "/", TESTS_BUILD_PATH "/");
+  inputRecordRequestStart();
+  inputRecordFlush();
+  ASSERT_TRUE(inputRecordActive());
+  ASSERT_EQ(inputRecordGetError(), nullptr);
+  for (int i = 0; i < frames; i++) {
+    simuSetSwitch(0, (i / 40) % 3 - 1);
+    setTrimValue(0, 0, (i * 7) % 250 - 125);
+    g_tmr10ms += (i % 3);
+    doMixerCalculations();
+    inputRecordFlush();
+    recorded[i][0] = channelOutputs[0];
+    recorded[i][1] = channelOutputs[1];
+  }
+  inputRecordRequestStop();
+  inputRecordFlush();
+  EXPECT_FALSE(inputRecordActive());
+
+  std::string path = std::string(TESTS_BUILD_PATH) + inputRecordGetFilename();
+  simuFatfsSetPaths("", "");
+
+  MIXER_RESET();
+  simuSetSwitch(0, -1);
+  setTrimValue(0, 0, 0);
+
+  ASSERT_EQ(inputReplayOpen(path.c_str()), nullptr);
+  for (int i = 0; i < frames; i++) {
+    ASSERT_TRUE(inputReplayNextFrame());
+    doMixerCalculations();
+    EXPECT_EQ(recorded[i][0], channelOutputs[0]);
+    EXPECT_EQ(recorded[i][1], channelOutputs[1]);
+  }
+  EXPECT_FALSE(inputReplayNextFrame());
+  inputReplayClose();
+  remove(path.c_str());
+}
+
 TEST_F(TrimsTest, throttleTrimEle) {
   SYSTEM_RESET();
   MODEL_RESET();
@@ -846,6 +1372,50 @@ TEST_F(MixerTest, flightModeTransition)
   CHECK_FLIGHT_MODE_TRANSITION(0, 1000, 1024, -102);
 }
 
+TEST_F(MixerTest, flightModeTransitionSharedChannels)
+{
+  SYSTEM_RESET();
+  MODEL_RESET();
+  MIXER_RESET();
+  setModelDefaults();
+  g_model.flightModeData[1].swtch = SWSRC_FIRST_SWITCH + 2;
+  g_model.flightModeData[0].fadeOut = 100;
+  g_model.flightModeData[1].fadeIn = 100;
+  // CH1 depends on the flight mode
+  g_model.mixData[0].destCh = 0;
+  g_model.mixData[0].srcRaw = MIXSRC_MAX;
+  g_model.mixData[0].flightModes = 0b11110;
+  g_model.mixData[0].weight = 100;
+  g_model.mixData[1].destCh = 0;
+  g_model.mixData[1].srcRaw = MIXSRC_MAX;
+  g_model.mixData[1].flightModes = 0b11101;
+  g_model.mixData[1].weight = -10;
+  // CH2 is the same in all flight modes
+  g_model.mixData[2].destCh = 1;
+  g_model.mixData[2].srcRaw = MIXSRC_MAX;
+  g_model.mixData[2].weight = 50;
+  // CH3 follows CH1, CH4 follows CH2
+  g_model.mixData[3].destCh = 2;
+  g_model.mixData[3].srcRaw = MIXSRC_FIRST_CH;
+  g_model.mixData[3].weight = 100;
+  g_model.mixData[4].destCh = 3;
+  g_model.mixData[4].srcRaw = MIXSRC_FIRST_CH + 1;
+  g_model.mixData[4].weight = 100;
+  evalMixes(1);
+  simuSetSwitch(0, 1);
+
+  int16_t last = 1024;
+  for (int i = 0; i < 1100; i++) {
+    evalMixes(1);
+    EXPECT_LE(channelOutputs[0], last);
+    EXPECT_LE(abs(channelOutputs[0] - channelOutputs[2]), 1);
+    EXPECT_EQ(512, channelOutputs[1]);
+    EXPECT_EQ(512, channelOutputs[3]);
+    last = channelOutputs[0];
+  }
+  EXPECT_EQ(-102, channelOutputs[0]);
+}
+
 TEST_F(MixerTest, flightModeOverflow)
 {
   SYSTEM_RESET();
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "gtests.h"
+#include "mixer_scheduler.h"
+
+#define INTERNAL_DUE  (1 << INTERNAL_MODULE)
+#define EXTERNAL_DUE  (1 << EXTERNAL_MODULE)
+
+class MixerSchedulerTest : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+      memset(schedules, 0, sizeof(schedules));
+    }
+
+    // runs the scheduler as the timer ISR does, returns the due modules
+    uint8_t advance(uint32_t elapsedUs, bool heartbeat = false)
+    {
+      uint8_t due = 0;
+      next = mixerSchedulesAdvance(schedules, elapsedUs, heartbeat, due);
+      return due;
+    }
+
+    MixerSchedule schedules[NUM_MODULES];
+    uint32_t next = 0;
+};
+
+TEST_F(MixerSchedulerTest, NoModuleScheduled)
+{
+  EXPECT_EQ(INTERNAL_DUE | EXTERNAL_DUE, advance(4000));
+  EXPECT_EQ(0u, next);
+}
+
+TEST_F(MixerSchedulerTest, TwoPeriods)
+{
+  schedules[INTERNAL_MODULE].period = 4000;
+  schedules[EXTERNAL_MODULE].period = 7000;
+
+  EXPECT_EQ(INTERNAL_DUE | EXTERNAL_DUE, advance(0));
+  EXPECT_EQ(4000u, next);
+
+  EXPECT_EQ(INTERNAL_DUE, advance(next));
+  EXPECT_EQ(3000u, next);
+
+  EXPECT_EQ(EXTERNAL_DUE, advance(next));
+  EXPECT_EQ(1000u, next);
+
+  EXPECT_EQ(INTERNAL_DUE, advance(next));
+  EXPECT_EQ(4000u, next);
+
+  EXPECT_EQ(0, advance(2000));
+  EXPECT_EQ(2000u, next);
+
+  EXPECT_EQ(INTERNAL_DUE, advance(next));
+  EXPECT_EQ(2000u, next);
+
+  EXPECT_EQ(EXTERNAL_DUE, advance(next));
+  EXPECT_EQ(2000u, next);
+}
+
+TEST_F(MixerSchedulerTest, CloseFramesAreMerged)
+{
+  schedules[INTERNAL_MODULE].period = 4000;
+  schedules[EXTERNAL_MODULE].period = 4000 + MIXER_SCHEDULER_MERGE_US / 2;
+
+  advance(0);
+  EXPECT_EQ(4000u, next);
+
+  // the external frame is close enough to be served by the same mixer run
+  EXPECT_EQ(INTERNAL_DUE | EXTERNAL_DUE, advance(next));
+  EXPECT_EQ(4000u, next);
+  EXPECT_EQ(4000 + MIXER_SCHEDULER_MERGE_US, schedules[EXTERNAL_MODULE].remaining);
+}
+
+TEST_F(MixerSchedulerTest, MissedFramesRestartThePhase)
+{
+  schedules[INTERNAL_MODULE].period = 4000;
+  schedules[EXTERNAL_MODULE].period = 7000;
+  advance(0);
+
+  // a late frame keeps the phase
+  EXPECT_EQ(INTERNAL_DUE, advance(5000));
+  EXPECT_EQ(3000, schedules[INTERNAL_MODULE].remaining);
+  EXPECT_EQ(2000, schedules[EXTERNAL_MODULE].remaining);
+
+  // the mixer was late by more than a period of both modules
+  EXPECT_EQ(INTERNAL_DUE | EXTERNAL_DUE, advance(15000));
+  EXPECT_EQ(4000, schedules[INTERNAL_MODULE].remaining);
+  EXPECT_EQ(7000, schedules[EXTERNAL_MODULE].remaining);
+  EXPECT_EQ(4000u, next);
+}
+
+TEST_F(MixerSchedulerTest, HeartbeatGivesTheInternalPhase)
+{
+  schedules[INTERNAL_MODULE].period = 4000;
+  schedules[EXTERNAL_MODULE].period = 7000;
+  advance(0);
+
+  // the internal module frame starts 1ms earlier than scheduled
+  EXPECT_EQ(INTERNAL_DUE, advance(3000, true));
+  EXPECT_EQ(4000, schedules[INTERNAL_MODULE].remaining);
+  EXPECT_EQ(4000, schedules[EXTERNAL_MODULE].remaining);
+  EXPECT_EQ(4000u, next);
+
+  EXPECT_EQ(INTERNAL_DUE | EXTERNAL_DUE, advance(next));
+}
+
+TEST_F(MixerSchedulerTest, UnscheduledModuleFollowsTheMixer)
+{
+  schedules[INTERNAL_MODULE].period = 4000;
+  advance(0);
+
+  EXPECT_EQ(EXTERNAL_DUE, advance(1000));
+  EXPECT_EQ(3000u, next);
+  EXPECT_EQ(INTERNAL_DUE | EXTERNAL_DUE, advance(next));
+}
@@ -116,3 +116,57 @@ TEST(Sources, getSourceString)
   EXPECT_STREQ(getSourceString(MIXSRC_TrimEle), STR_CHAR_TRIM "Ele");
   EXPECT_STREQ(getSourceString(MIXSRC_TrimThr), STR_CHAR_TRIM "Thr");
 }
+
+class SourcesTest : public OpenTxTest {};
+
+TEST_F(SourcesTest, getValue)
+{
+  bool valid = true;
+  EXPECT_EQ(getValue(MIXSRC_NONE, &valid), 0);
+  EXPECT_FALSE(valid);
+
+  valid = true;
+  EXPECT_EQ(getValue(MIXSRC_LAST_TELEM + 1, &valid), 0);
+  EXPECT_FALSE(valid);
+
+  valid = true;
+  EXPECT_EQ(getValue(MIXSRC_MIN, &valid), -RESX);
+  EXPECT_EQ(getValue(MIXSRC_MAX, &valid), RESX);
+  EXPECT_TRUE(valid);
+
+  ex_chans[2] = 345;
+  EXPECT_EQ(getValue(MIXSRC_FIRST_CH + 2), 345);
+
+  simuSetSwitch(0, -1);
+  evalMixes(1);
+  EXPECT_EQ(getValue(MIXSRC_FIRST_SWITCH), -1024);
+  simuSetSwitch(0, 1);
+  evalMixes(1);
+  EXPECT_EQ(getValue(MIXSRC_FIRST_SWITCH), 1024);
+}
+
+TEST_F(SourcesTest, getValues)
+{
+  const mixsrc_t sources[] = {
+    MIXSRC_NONE,
+    MIXSRC_FIRST_STICK,
+    MIXSRC_MIN,
+    MIXSRC_MAX,
+    MIXSRC_FIRST_TRIM,
+    MIXSRC_FIRST_SWITCH,
+    MIXSRC_FIRST_LOGICAL_SWITCH,
+    MIXSRC_FIRST_CH + 1,
+    MIXSRC_TX_VOLTAGE,
+    MIXSRC_FIRST_TIMER,
+    MIXSRC_LAST_TELEM + 1,
+  };
+  getvalue_t values[DIM(sources)];
+
+  ex_chans[1] = -512;
+  getValues(sources, values, DIM(sources));
+
+  for (unsigned i = 0; i < DIM(sources); i++) {
+    EXPECT_EQ(values[i], getValue(sources[i])) << "source " << sources[i];
+  }
+  EXPECT_EQ(values[7], -512);
+}
@@ -318,3 +318,55 @@ TEST(getSwitch, edgeRelease)
   EXPECT_EQ(getSwitch(SWSRC_SW2), false);
 
 }
+
+#define SWSRC_SW3 (SWSRC_FIRST_LOGICAL_SWITCH + 2)
+#define SWSRC_SW4 (SWSRC_FIRST_LOGICAL_SWITCH + 3)
+
+TEST(evalLogicalSwitches, dependencies)
+{
+  RADIO_RESET();
+  MODEL_RESET();
+  MIXER_RESET();
+
+  // L1 follows SA0, L2 to L4 only depend on other logical switches,
+  // L3 reads L4 which is evaluated after it
+  setLogicalSwitch(0, LS_FUNC_AND, SWSRC_FIRST_SWITCH, SWSRC_NONE);
+  setLogicalSwitch(1, LS_FUNC_AND, SWSRC_SW1, SWSRC_NONE);
+  setLogicalSwitch(3, LS_FUNC_AND, SWSRC_SW3, SWSRC_ON);
+  setLogicalSwitch(2, LS_FUNC_AND, SWSRC_SW2, -SWSRC_SW4);
+
+  simuSetSwitch(0, 0);
+  evalLogicalSwitches();
+  EXPECT_EQ(getSwitch(SWSRC_SW1), false);
+  EXPECT_EQ(getSwitch(SWSRC_SW2), false);
+  EXPECT_EQ(getSwitch(SWSRC_SW3), false);
+  EXPECT_EQ(getSwitch(SWSRC_SW4), false);
+
+  simuSetSwitch(0, -1);
+  evalLogicalSwitches();
+  EXPECT_EQ(getSwitch(SWSRC_SW1), true);
+  EXPECT_EQ(getSwitch(SWSRC_SW2), true);
+  EXPECT_EQ(getSwitch(SWSRC_SW3), true);
+  EXPECT_EQ(getSwitch(SWSRC_SW4), true);
+
+  // L3 sees L4 one cycle later
+  evalLogicalSwitches();
+  EXPECT_EQ(getSwitch(SWSRC_SW3), false);
+  EXPECT_EQ(getSwitch(SWSRC_SW4), false);
+  evalLogicalSwitches();
+  EXPECT_EQ(getSwitch(SWSRC_SW3), true);
+  EXPECT_EQ(getSwitch(SWSRC_SW4), true);
+
+  simuSetSwitch(0, 0);
+  evalLogicalSwitches();
+  EXPECT_EQ(getSwitch(SWSRC_SW1), false);
+  EXPECT_EQ(getSwitch(SWSRC_SW2), false);
+  EXPECT_EQ(getSwitch(SWSRC_SW3), false);
+  EXPECT_EQ(getSwitch(SWSRC_SW4), false);
+
+  // an edited switch is taken into account once the model is marked dirty
+  setLogicalSwitch(1, LS_FUNC_AND, -SWSRC_SW1, SWSRC_NONE);
+  storageDirty(EE_MODEL);
+  evalLogicalSwitches();
+  EXPECT_EQ(getSwitch(SWSRC_SW2), true);
+}
@@ -130,6 +130,19 @@ TEST(Timers, timerAbsolute)
 
 }
 
+TEST(Timers, timerAtMaxDoesNotStopOthers)
+{
+  initModelTimer(0, TMRMODE_ON, 0);
+  initModelTimer(1, TMRMODE_ON, 0);
+  timerSet(0, TIMER_MAX);
+  timerReset(1);
+
+  EXPECT_TRUE(evalTimersForNSecondsAndTest(10, THR_100, 0, TMR_RUNNING, TIMER_MAX));
+  EXPECT_TRUE(evalTimersForNSecondsAndTest(0,  THR_100, 1, TMR_RUNNING, 10));
+
+  initModelTimer(1, TMRMODE_OFF, 0);
+}
+
 TEST(Timers, timerThrottle)
 {
   initModelTimer(0, TMRMODE_THR, 0);
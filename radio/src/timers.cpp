@@ -71,115 +71,136 @@ void saveTimers()
 
 #define THR_TRG_TRESHOLD    13      // approximately 10% full throttle
 
-void evalTimers(int16_t throttle, uint8_t tick10ms)
+// Timer value from which AUDIO_TIMER_COUNTDOWN() may play something: above
+// both the countdown window and the 30s call, it would not play anything
+static tmrval_t getTimerCountdownDeadline(uint8_t idx)
 {
-  for (uint8_t i=0; i<TIMERS; i++) {
-    tmrmode_t timerMode = g_model.timers[i].mode;
-    tmrstart_t timerStart = g_model.timers[i].start;
-    int16_t     timerSwtch = g_model.timers[i].swtch;
-    TimerState * timerState = &timersStates[i];
-    uint32_t showElapsed = g_model.timers[i].showElapsed;
-
-    if (timerMode) {
-      if ((timerState->state == TMR_OFF)
-          && (timerMode != TMRMODE_THR_START)
-          && (timerMode != TMRMODE_START)) {
-       
-        timerState->state = TMR_RUNNING;
+  if (!g_model.timers[idx].countdownBeep || !g_model.timers[idx].start)
+    return TIMER_MIN;
+  return max<tmrval_t>(TIMER_COUNTDOWN_START(idx), 30);
+}
+
+// Timer state changes and announcements, once per timer second
+static void evalTimerSecond(uint8_t idx, int16_t throttle)
+{
+  const TimerData & timer = g_model.timers[idx];
+  TimerState * timerState = &timersStates[idx];
+  tmrmode_t timerMode = timer.mode;
+  tmrstart_t timerStart = timer.start;
+
+  if (timerState->val == TIMER_MAX) return;
+  if (timerState->val == TIMER_MIN) return;
+
+  timerState->val_10ms -= 100;
+  tmrval_t newTimerVal = timerState->val;
+  if (timerStart) newTimerVal = timerStart - newTimerVal;
+
+  if (timerMode == TMRMODE_START) {
+    // Start timer based on switch
+    if (timerState->state == TMR_OFF && getSwitch(timer.swtch)) {
+      timerState->state = TMR_RUNNING;  // start timer running
+      timerState->cnt = 0;
+      timerState->sum = 0;
+    }
+    if (timerState->state != TMR_OFF) {
+      newTimerVal++;
+    }
+  } else if (getSwitch(timer.swtch)) {
+    // Modes conditional on switch at any time
+    if (timerMode == TMRMODE_ON) {
+      newTimerVal++;
+    } else if (timerMode == TMRMODE_THR) {
+      if (throttle) newTimerVal++;
+    } else if (timerMode == TMRMODE_THR_REL) {
+      // throttle was normalized to 0 to 128 value
+      // (throttle/64*2 (because - range is added as well)
+      if ((timerState->sum / timerState->cnt) >= 128) {
+        newTimerVal++;  // add second used of throttle
+        timerState->sum -= 128 * timerState->cnt;
+      }
+      timerState->cnt = 0;
+    } else if (timerMode == TMRMODE_THR_START) {
+      // we can't rely on (throttle || newTimerVal > 0) as a detection if
+      // timer should be running because having persistent timer brakes
+      // this rule
+      if ((throttle > THR_TRG_TRESHOLD) && timerState->state == TMR_OFF) {
+        timerState->state = TMR_RUNNING;  // start timer running
         timerState->cnt = 0;
         timerState->sum = 0;
+        // TRACE("Timer[%d] THr triggered", idx);
       }
+      if (timerState->state != TMR_OFF) newTimerVal++;
+    }
+  }
 
-      if (timerMode == TMRMODE_THR_REL) {
-        timerState->cnt++;
-        timerState->sum += throttle;
+  switch (timerState->state) {
+    case TMR_RUNNING:
+      if (timerStart && newTimerVal >= (tmrval_t)timerStart) {
+        AUDIO_TIMER_ELAPSED(idx);
+        timerState->state = TMR_NEGATIVE;
+        // TRACE("Timer[%d] negative", idx);
       }
+      break;
+    case TMR_NEGATIVE:
+      if (newTimerVal >= (tmrval_t)timerStart + MAX_ALERT_TIME) {
+        timerState->state = TMR_STOPPED;
+        // TRACE("Timer[%d] stopped state at %d", idx, newTimerVal);
+      }
+      break;
+  }
 
-      if ((timerState->val_10ms += tick10ms) >= 100) {
-        if (timerState->val == TIMER_MAX) break;
-        if (timerState->val == TIMER_MIN) break;
-
-        timerState->val_10ms -= 100;
-        tmrval_t newTimerVal = timerState->val;
-        if (timerStart) newTimerVal = timerStart - newTimerVal;
-
-        if (timerMode == TMRMODE_START) {
-          // Start timer based on switch
-          if (getSwitch(timerSwtch) && timerState->state == TMR_OFF) {
-            timerState->state = TMR_RUNNING;  // start timer running
-            timerState->cnt = 0;
-            timerState->sum = 0;
-          }
-          if (timerState->state != TMR_OFF) {
-            newTimerVal++;
-          } 
-        } else if (getSwitch(timerSwtch)) {
-
-          // Modes conditional on switch at any time
-          if (timerMode == TMRMODE_ON) {
-            newTimerVal++;
-          } else if (timerMode == TMRMODE_THR) {
-            if (throttle) newTimerVal++;
-          } else if (timerMode == TMRMODE_THR_REL) {
-            // throttle was normalized to 0 to 128 value
-            // (throttle/64*2 (because - range is added as well)
-            if ((timerState->sum / timerState->cnt) >= 128) {  
-              newTimerVal++;  // add second used of throttle
-              timerState->sum -= 128 * timerState->cnt;
-            }
-            timerState->cnt = 0;
-          } else if (timerMode == TMRMODE_THR_START) {
-            // we can't rely on (throttle || newTimerVal > 0) as a detection if
-            // timer should be running because having persistent timer brakes
-            // this rule
-            if ((throttle > THR_TRG_TRESHOLD) && timerState->state == TMR_OFF) {
-              timerState->state = TMR_RUNNING;  // start timer running
-              timerState->cnt = 0;
-              timerState->sum = 0;
-              // TRACE("Timer[%d] THr triggered", i);
-            }
-            if (timerState->state != TMR_OFF) newTimerVal++;
-          }
-        }
-
-        switch (timerState->state) {
-          case TMR_RUNNING:
-            if (timerStart && newTimerVal >= (tmrval_t)timerStart) {
-              AUDIO_TIMER_ELAPSED(i);
-              timerState->state = TMR_NEGATIVE;
-              // TRACE("Timer[%d] negative", i);
-            }
-            break;
-          case TMR_NEGATIVE:
-            if (newTimerVal >= (tmrval_t)timerStart + MAX_ALERT_TIME) {
-              timerState->state = TMR_STOPPED;
-              // TRACE("Timer[%d] stopped state at %d", i, newTimerVal);
-            }
-            break;
-        }
+  // if counting backwards - display backwards
+  if (timerStart) newTimerVal = timerStart - newTimerVal;
 
-        // if counting backwards - display backwards
-        if (timerStart) newTimerVal = timerStart - newTimerVal;
-
-        if (newTimerVal != timerState->val) {
-          timerState->val = newTimerVal;
-          if (timerState->state == TMR_RUNNING) {
-            if (g_model.timers[i].countdownBeep && g_model.timers[i].start) {
-              AUDIO_TIMER_COUNTDOWN(i, newTimerVal);
-            }
-            tmrval_t announceVal = newTimerVal;
-            if (showElapsed) announceVal = timerStart - newTimerVal;
-            if (g_model.timers[i].minuteBeep && (announceVal % 60) == 0) {
-              AUDIO_TIMER_MINUTE(announceVal);
-              // TRACE("Timer[%d] %d minute announcement", i, newTimerVal/60);
-            }
-          }
+  if (newTimerVal != timerState->val) {
+    timerState->val = newTimerVal;
+    if (timerState->state == TMR_RUNNING) {
+      if (newTimerVal <= getTimerCountdownDeadline(idx)) {
+        AUDIO_TIMER_COUNTDOWN(idx, newTimerVal);
+      }
+      if (timer.minuteBeep) {
+        tmrval_t announceVal = newTimerVal;
+        if (timer.showElapsed) announceVal = timerStart - newTimerVal;
+        if ((announceVal % 60) == 0) {
+          AUDIO_TIMER_MINUTE(announceVal);
+          // TRACE("Timer[%d] %d minute announcement", idx, newTimerVal/60);
         }
       }
     }
   }
 }
 
+// Called every 10ms tick: only the throttle average and the 10ms counters
+// are updated, the timers switches and announcements are only looked at
+// when a timer second has elapsed
+void evalTimers(int16_t throttle, uint8_t tick10ms)
+{
+  for (uint8_t i=0; i<TIMERS; i++) {
+    tmrmode_t timerMode = g_model.timers[i].mode;
+    if (!timerMode)
+      continue;
+
+    TimerState * timerState = &timersStates[i];
+
+    if ((timerState->state == TMR_OFF)
+        && (timerMode != TMRMODE_THR_START)
+        && (timerMode != TMRMODE_START)) {
+      timerState->state = TMR_RUNNING;
+      timerState->cnt = 0;
+      timerState->sum = 0;
+    }
+
+    if (timerMode == TMRMODE_THR_REL) {
+      timerState->cnt++;
+      timerState->sum += throttle;
+    }
+
+    if ((timerState->val_10ms += tick10ms) >= 100) {
+      evalTimerSecond(i, throttle);
+    }
+  }
+}
+
 int16_t throttleSource2Source(int16_t thrSrc)
 {
   if (thrSrc == 0) {
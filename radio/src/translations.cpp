@@ -211,6 +211,7 @@ const char STR_DREX[] = TR_DREX;
 const char STR_CURVE[] = TR_CURVE;
 const char STR_FLMODE[] = TR_FLMODE;
 const char STR_MIXWARNING[] = TR_MIXWARNING;
+const char STR_MIX_LOOP[] = TR_MIX_LOOP;
 const char STR_OFF[] = TR_OFF;
 const char STR_ANTENNA[]  = TR_ANTENNA;
 const char STR_NO_INFORMATION[]  = TR_NO_INFORMATION;
@@ -272,6 +273,10 @@ const char STR_NODATA[] = TR_NODATA;
 const char STR_US[] = TR_US;
 const char STR_HZ[]  = TR_HZ;
 const char STR_TMIXMAXMS[] = TR_TMIXMAXMS;
+const char STR_TMIXP99[] = TR_TMIXP99;
+const char STR_TMIXEST[] = TR_TMIXEST;
+const char STR_P99_US[] = TR_P99_US;
+const char STR_P999_US[] = TR_P999_US;
 const char STR_FREE_STACK[] = TR_FREE_STACK;
 const char STR_INT_GPS_LABEL[]  = TR_INT_GPS_LABEL;
 const char STR_HEARTBEAT_LABEL[]  = TR_HEARTBEAT_LABEL;
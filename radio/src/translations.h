@@ -346,6 +346,7 @@ extern const char STR_DREX[];
 extern const char STR_CURVE[];
 extern const char STR_FLMODE[];
 extern const char STR_MIXWARNING[];
+extern const char STR_MIX_LOOP[];
 extern const char STR_OFF[];
 extern const char STR_ANTENNA[];
 extern const char STR_NO_INFORMATION[];
@@ -449,6 +450,10 @@ extern const char STR_NODATA[];
 extern const char STR_US[];
 extern const char STR_HZ[];
 extern const char STR_TMIXMAXMS[];
+extern const char STR_TMIXP99[];
+extern const char STR_TMIXEST[];
+extern const char STR_P99_US[];
+extern const char STR_P999_US[];
 extern const char STR_FREE_STACK[];
 extern const char STR_INT_GPS_LABEL[];
 extern const char STR_HEARTBEAT_LABEL[];
@@ -294,6 +294,7 @@
 #define TR_CURVE                       "曲线"
 #define TR_FLMODE                      TR("飞行模式", "飞行模式")
 #define TR_MIXWARNING                  "警告"
+#define TR_MIX_LOOP                    "LOOP!"
 #define TR_OFF                         "禁用"
 #define TR_ANTENNA                     "天线"
 #define TR_NO_INFORMATION              TR("无信息", "无信息")
@@ -399,6 +400,10 @@
 #define TR_US                          "us"
 #define TR_HZ                          "Hz"
 #define TR_TMIXMAXMS                   "Tmix max"
+#define TR_TMIXP99                     "Tmix p99"
+#define TR_TMIXEST                     "Tmix guess"
+#define TR_P99_US                      "p99(us) "
+#define TR_P999_US                     "p999(us) "
 #define TR_FREE_STACK                  "Free stack"
 #define TR_INT_GPS_LABEL               "Internal GPS"
 #define TR_HEARTBEAT_LABEL             "Heartbeat"
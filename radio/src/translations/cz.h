@@ -309,6 +309,7 @@
 #define TR_CURVE                       "Křivka"
 #define TR_FLMODE                      "Režim"
 #define TR_MIXWARNING                  "Varování"
+#define TR_MIX_LOOP                    "LOOP!"
 #define TR_OFF                         "VYP"
 #define TR_ANTENNA                     "Anténa"
 #define TR_NO_INFORMATION              TR("Není info.", "Žádná informace")
@@ -414,6 +415,10 @@
 #define TR_HZ                          "Hz"
 
 #define TR_TMIXMAXMS                   "Tmix max"
+#define TR_TMIXP99                     "Tmix p99"
+#define TR_TMIXEST                     "Tmix guess"
+#define TR_P99_US                      "p99(us) "
+#define TR_P999_US                     "p999(us) "
 #define TR_FREE_STACK                  "Free stack"
 #define TR_INT_GPS_LABEL               "Vnitřní GPS"
 #define TR_HEARTBEAT_LABEL             "Heartbeat"
@@ -303,6 +303,7 @@
 #define TR_CURVE                       "Kurve"
 #define TR_FLMODE                      TR("Tilstand", "Tilstande")
 #define TR_MIXWARNING                  "Advarsel"
+#define TR_MIX_LOOP                    "LOOP!"
 #define TR_OFF                         "FRA"
 #define TR_ANTENNA                     "Antenne"
 #define TR_NO_INFORMATION              TR("Ingen info", "Ingen information")
@@ -409,6 +410,10 @@
 #define TR_US                          "us"
 #define TR_HZ                          "Hz"
 #define TR_TMIXMAXMS                   "Tmix max"
+#define TR_TMIXP99                     "Tmix p99"
+#define TR_TMIXEST                     "Tmix guess"
+#define TR_P99_US                      "p99(us) "
+#define TR_P999_US                     "p999(us) "
 #define TR_FREE_STACK                  "Fri stak"
 #define TR_INT_GPS_LABEL               "Intern GPS"
 #define TR_HEARTBEAT_LABEL             "Hjerte puls"
@@ -300,6 +300,7 @@
 #define TR_CURVE                       "Kurve"
 #define TR_FLMODE                      TR("Phase", "Phasen")
 #define TR_MIXWARNING                  "Warnung"
+#define TR_MIX_LOOP                    "LOOP!"
 #define TR_OFF                         "AUS"
 #define TR_ANTENNA                     "Antenne"
 #define TR_NO_INFORMATION              TR("No info", "No information")
@@ -405,6 +406,10 @@
 #define TR_US                          "us"
 #define TR_HZ                          "Hz"
 #define TR_TMIXMAXMS         	       "Tmix max"
+#define TR_TMIXP99                     "Tmix p99"
+#define TR_TMIXEST                     "Tmix guess"
+#define TR_P99_US                      "p99(us) "
+#define TR_P999_US                     "p999(us) "
 #define TR_FREE_STACK     		       "Freier Stack"
 #define TR_INT_GPS_LABEL               "Internal GPS"
 #define TR_HEARTBEAT_LABEL             "Heartbeat"
@@ -311,6 +311,7 @@
 #define TR_CURVE                       "Curve"
 #define TR_FLMODE                      TR("Mode","Modes")
 #define TR_MIXWARNING                  "Warning"
+#define TR_MIX_LOOP                    "LOOP!"
 #define TR_OFF                         "OFF"
 #define TR_ANTENNA                     "Antenna"
 #define TR_NO_INFORMATION              TR("No info", "No information")
@@ -410,6 +411,10 @@
 #define TR_US                          "us"
 #define TR_HZ                          "Hz"
 #define TR_TMIXMAXMS                   "Tmix max"
+#define TR_TMIXP99                     "Tmix p99"
+#define TR_TMIXEST                     "Tmix guess"
+#define TR_P99_US                      "p99(us) "
+#define TR_P999_US                     "p999(us) "
 #define TR_FREE_STACK                  "Free stack"
 #define TR_INT_GPS_LABEL               "Internal GPS"
 #define TR_HEARTBEAT_LABEL             "Heartbeat"
@@ -309,6 +309,7 @@
 #define TR_CURVE                       "Courbe"
 #define TR_FLMODE                      TR("Phase", "Phases")
 #define TR_MIXWARNING                  "Alerte"
+#define TR_MIX_LOOP                    "LOOP!"
 #define TR_OFF                         "OFF"
 #define TR_ANTENNA                     "Antenne"
 #define TR_NO_INFORMATION              TR("Pas d'info", "Pas d'information")
@@ -414,6 +415,10 @@
 #define TR_HZ                          "Hz"
 
 #define TR_TMIXMAXMS                   "Tmix max"
+#define TR_TMIXP99                     "Tmix p99"
+#define TR_TMIXEST                     "Tmix guess"
+#define TR_P99_US                      "p99(us) "
+#define TR_P999_US                     "p999(us) "
 #define TR_FREE_STACK                  "Pile libre"
 #define TR_INT_GPS_LABEL               "GPS interne"
 #define TR_HEARTBEAT_LABEL             "Heartbeat"
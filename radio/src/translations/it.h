@@ -299,6 +299,7 @@
 #define TR_CURVE                        "Curva"
 #define TR_FLMODE                       TR("Fase", "Fasi")
 #define TR_MIXWARNING                   "Avviso"
+#define TR_MIX_LOOP                     "LOOP!"
 #define TR_OFF                          "OFF"
 #define TR_ANTENNA                      "Antenna"
 #define TR_NO_INFORMATION               TR("No info", "No informazione")
@@ -403,6 +404,10 @@
 #define TR_US                           "us"
 #define TR_HZ                           "Hz"
 #define TR_TMIXMAXMS                    "Tmix max"
+#define TR_TMIXP99                      "Tmix p99"
+#define TR_TMIXEST                      "Tmix guess"
+#define TR_P99_US                       "p99(us) "
+#define TR_P999_US                      "p999(us) "
 #define TR_FREE_STACK                   "Stack libero"
 #define TR_INT_GPS_LABEL                "GPS interno"
 #define TR_HEARTBEAT_LABEL              "Heartbeat"
@@ -300,6 +300,7 @@
 #define TR_CURVE                       "カーブ"
 #define TR_FLMODE                      TR("Mode", "モード")
 #define TR_MIXWARNING                  "警告"
+#define TR_MIX_LOOP                    "LOOP!"
 #define TR_OFF                         "OFF"
 #define TR_ANTENNA                     "アンテナ"
 #define TR_NO_INFORMATION              TR("No info", "情報なし")
@@ -404,6 +405,10 @@
 #define TR_US                          "us"
 #define TR_HZ                          "Hz"
 #define TR_TMIXMAXMS                   "Tmix max"
+#define TR_TMIXP99                     "Tmix p99"
+#define TR_TMIXEST                     "Tmix guess"
+#define TR_P99_US                      "p99(us) "
+#define TR_P999_US                     "p999(us) "
 #define TR_FREE_STACK                  "Free stack"
 #define TR_INT_GPS_LABEL               "内蔵GPS"
 #define TR_HEARTBEAT_LABEL             "Heartbeat"
@@ -297,6 +297,7 @@
 #define TR_CURVE               "Krzywa"
 #define TR_FLMODE              "Tryb"
 #define TR_MIXWARNING          "UWAGA"
+#define TR_MIX_LOOP            "LOOP!"
 #define TR_OFF                 "Wył."
 #define TR_ANTENNA                     "Antenna"
 #define TR_NO_INFORMATION              TR("No info", "No information")
@@ -400,6 +401,10 @@
 #define TR_US                         "us"
 #define TR_HZ                         "Hz"
 #define TR_TMIXMAXMS                  "TmixMaks"
+#define TR_TMIXP99                    "Tmix p99"
+#define TR_TMIXEST                    "Tmix guess"
+#define TR_P99_US                     "p99(us) "
+#define TR_P999_US                    "p999(us) "
 #define TR_FREE_STACK                 "Wolny stos"
 #define TR_INT_GPS_LABEL              "Wewnęt. GPS"
 #define TR_HEARTBEAT_LABEL            "Heartbeat"
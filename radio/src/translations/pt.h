@@ -303,6 +303,7 @@
 #define TR_CURVE                       "Curva"
 #define TR_FLMODE                      TR("Modo", "Modos")
 #define TR_MIXWARNING                  "Alerta"
+#define TR_MIX_LOOP                    "LOOP!"
 #define TR_OFF                         "DESL"
 #define TR_ANTENNA                     "Antena"
 #define TR_NO_INFORMATION              TR("No info", "No information")
@@ -407,6 +408,10 @@
 #define TR_US                          "us"
 #define TR_HZ                          "Hz"
 #define TR_TMIXMAXMS                   "Tmix max"
+#define TR_TMIXP99                     "Tmix p99"
+#define TR_TMIXEST                     "Tmix guess"
+#define TR_P99_US                      "p99(us) "
+#define TR_P999_US                     "p999(us) "
 #define TR_FREE_STACK                  "Free stack"
 #define TR_INT_GPS_LABEL               "Internal GPS"
 #define TR_HEARTBEAT_LABEL             "Heartbeat"
@@ -313,6 +313,7 @@
 #define TR_CURVE                        "Kurva"
 #define TR_FLMODE                       TR("Flygläge","Flyglägen")
 #define TR_MIXWARNING                   "Varning"
+#define TR_MIX_LOOP                     "LOOP!"
 #define TR_OFF                          "AV"
 #define TR_ANTENNA                      "Antenn"
 #define TR_NO_INFORMATION               TR("Ingen info", "Ingen information")
@@ -425,6 +426,10 @@
 #define TR_HZ                           "Hz"
 
 #define TR_TMIXMAXMS                    "Tmix max"
+#define TR_TMIXP99                      "Tmix p99"
+#define TR_TMIXEST                      "Tmix guess"
+#define TR_P99_US                       "p99(us) "
+#define TR_P999_US                      "p999(us) "
 #define TR_FREE_STACK                   "Fri stack"
 #define TR_INT_GPS_LABEL                "Intern GPS"
 #define TR_HEARTBEAT_LABEL              "Heartbeat"
@@ -299,6 +299,7 @@
 #define TR_CURVE                       "曲線"
 #define TR_FLMODE                      TR("飛行模式", "飛行模式")
 #define TR_MIXWARNING                  "警告"
+#define TR_MIX_LOOP                    "LOOP!"
 #define TR_OFF                         "禁用"
 #define TR_ANTENNA                     "天線"
 #define TR_NO_INFORMATION              TR("無信息", "無信息")
@@ -403,6 +404,10 @@
 #define TR_US                          "us"
 #define TR_HZ                          "Hz"
 #define TR_TMIXMAXMS                   "Tmix max"
+#define TR_TMIXP99                     "Tmix p99"
+#define TR_TMIXEST                     "Tmix guess"
+#define TR_P99_US                      "p99(us) "
+#define TR_P999_US                     "p999(us) "
 #define TR_FREE_STACK                  "Free stack"
 #define TR_INT_GPS_LABEL               "Internal GPS"
 #define TR_HEARTBEAT_LABEL             "Heartbeat"
@@ -0,0 +1,194 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+#
+# Copyright (C) EdgeTX
+#
+# Based on code named
+#   opentx - https://github.com/opentx/opentx
+#   th9x - http://code.google.com/p/th9x
+#   er9x - http://code.google.com/p/er9x
+#   gruvin9x - http://code.google.com/p/gruvin9x
+#
+# License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License version 2 as
+# published by the Free Software Foundation.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+
+# Converts the binary logs written by the radio (.etl, see
+# radio/src/logs_encoder.h) to the CSV layout of the former radio logs.
+
+import argparse
+import datetime
+import os
+import sys
+
+BLOCK_SIZE = 512
+MAGIC = b"ETXLOG"
+VERSION = 1
+
+RECORD_END = 0x00
+RECORD_HEADER = ord("H")
+RECORD_ROW = ord("R")
+
+COLUMN_VALUE = 0
+COLUMN_TIME = 1
+COLUMN_RTC = 2
+COLUMN_GPS = 3
+COLUMN_DATETIME = 4
+COLUMN_TEXT = 5
+COLUMN_BITS64 = 6
+
+# number of delta encoded values of each column type
+COLUMN_VALUES = {
+    COLUMN_VALUE: 1,
+    COLUMN_TIME: 1,
+    COLUMN_RTC: 2,
+    COLUMN_GPS: 2,
+    COLUMN_DATETIME: 2,
+    COLUMN_TEXT: 0,
+    COLUMN_BITS64: 2,
+}
+
+
+class LogError(Exception):
+    pass
+
+
+def read_varint(data, pos):
+    value = 0
+    shift = 0
+    while True:
+        if pos >= len(data):
+            raise LogError("truncated record")
+        byte = data[pos]
+        pos += 1
+        value |= (byte & 0x7F) << shift
+        if not byte & 0x80:
+            return value, pos
+        shift += 7
+
+
+def to_int32(value):
+    value &= 0xFFFFFFFF
+    return value - 0x100000000 if value & 0x80000000 else value
+
+
+def format_prec(value, prec):
+    if prec == 0:
+        return "%d" % value
+    sign = "-" if value < 0 else ""
+    quot, rem = divmod(abs(value), 10 ** prec)
+    return "%s%d.%0*d" % (sign, quot, prec, rem)
+
+
+def format_column(column_type, prec, values, text):
+    if column_type == COLUMN_VALUE:
+        return format_prec(values[0], prec)
+    if column_type == COLUMN_TIME:
+        return "%d" % values[0]
+    if column_type == COLUMN_RTC:
+        t = datetime.datetime(1970, 1, 1) + datetime.timedelta(seconds=values[0] & 0xFFFFFFFF)
+        return "%4d-%02d-%02d,%02d:%02d:%02d.%02d0" % (
+            t.year, t.month, t.day, t.hour, t.minute, t.second, values[1])
+    if column_type == COLUMN_GPS:
+        if values[0] and values[1]:
+            return "%s %s" % (format_prec(values[0], 6), format_prec(values[1], 6))
+        return ""
+    if column_type == COLUMN_DATETIME:
+        date, time = values
+        return "%4d-%02d-%02d %02d:%02d:%02d" % (
+            date // 10000, date // 100 % 100, date % 100,
+            time // 10000, time // 100 % 100, time % 100)
+    if column_type == COLUMN_TEXT:
+        return '"%s"' % text
+    if column_type == COLUMN_BITS64:
+        return "0x%08X%08X" % (values[0] & 0xFFFFFFFF, values[1] & 0xFFFFFFFF)
+    raise LogError("unknown column type %d" % column_type)
+
+
+def decode(data):
+    """Yields (is_header, CSV line) for each record of a binary log"""
+    columns = None
+    previous = []
+    pos = 0
+    while pos < len(data):
+        record = data[pos]
+        if record == RECORD_HEADER:
+            if data[pos + 1:pos + 1 + len(MAGIC)] != MAGIC:
+                raise LogError("bad header at offset %d" % pos)
+            pos += 1 + len(MAGIC)
+            if data[pos] != VERSION:
+                raise LogError("unsupported version %d" % data[pos])
+            count, pos = read_varint(data, pos + 1)
+            columns = []
+            labels = []
+            for _ in range(count):
+                column_type, prec = data[pos], data[pos + 1]
+                end = data.index(b"\0", pos + 2)
+                labels.append(data[pos + 2:end].decode("utf-8", "replace"))
+                columns.append((column_type, prec))
+                pos = end + 1
+            previous = [0] * sum(COLUMN_VALUES.get(t, 0) for t, _ in columns)
+            yield True, ",".join(labels)
+        elif record == RECORD_ROW:
+            if columns is None:
+                raise LogError("row without header at offset %d" % pos)
+            pos += 1
+            index = 0
+            fields = []
+            for column_type, prec in columns:
+                values = []
+                text = None
+                if column_type == COLUMN_TEXT:
+                    length, pos = read_varint(data, pos)
+                    text = data[pos:pos + length].decode("utf-8", "replace")
+                    pos += length
+                for _ in range(COLUMN_VALUES.get(column_type, 0)):
+                    zigzag, pos = read_varint(data, pos)
+                    delta = (zigzag >> 1) ^ -(zigzag & 1)
+                    previous[index] = to_int32(previous[index] + delta)
+                    values.append(previous[index])
+                    index += 1
+                fields.append(format_column(column_type, prec, values, text))
+            yield False, ",".join(fields)
+        else:
+            # end of block (or garbage left by a power loss)
+            pos = (pos // BLOCK_SIZE + 1) * BLOCK_SIZE
+            previous = [0] * len(previous)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert EdgeTX binary logs to CSV")
+    parser.add_argument("input", help="binary log (.etl)")
+    parser.add_argument("output", nargs="?", help="CSV file (input name with .csv by default, - for stdout)")
+    args = parser.parse_args()
+
+    with open(args.input, "rb") as f:
+        data = f.read()
+
+    output = args.output or os.path.splitext(args.input)[0] + ".csv"
+    out = sys.stdout if output == "-" else open(output, "w", newline="")
+    try:
+        # the logs appended to the same file usually share their header
+        header = None
+        for is_header, line in decode(data):
+            if is_header:
+                if line == header:
+                    continue
+                header = line
+            out.write(line + "\n")
+    except (LogError, IndexError, ValueError) as e:
+        sys.exit("%s: %s" % (args.input, e))
+    finally:
+        if out is not sys.stdout:
+            out.close()
+
+
+if __name__ == "__main__":
+    main()